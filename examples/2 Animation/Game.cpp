@@ -75,18 +75,15 @@ void Game::init()
     playerAnimaton.isPlaying = true;
 
     auto& playerTransform = m_player.addComponent<TransformComponent>().transform;
-    playerTransform.setPosition(m_renderTarget->getView().getSize().x / 2 - playerAnimaton.frameSize.x / 2, m_renderTarget->getView().getSize().y / 2 - playerAnimaton.frameSize.y / 2);
+    playerTransform.setPosition(m_renderTarget->getView().getSize().x / 2 - playerAnimaton.data->frameSize.x / 2, m_renderTarget->getView().getSize().y / 2 - playerAnimaton.data->frameSize.y / 2);
 
-    animationStateNames.reserve(m_player.getComponent<AnimationComponent>().states.size());
-    for(auto& state : m_player.getComponent<AnimationComponent>().states)
-    {
-        animationStateNames.emplace_back(state.first);
-    }
+    // the ID of each state is its index
+    animationStateNames = playerAnimaton.data->stateNames;
 
     // activate the player
     m_player.activate();
 
-    playerAnimaton.playingState = animationStateNames[0];
+    playerAnimaton.playingState = 0;
 }
 
 void Game::update(float deltaTime)
@@ -151,7 +148,7 @@ void Game::handleEvents(sf::Event event)
                     if(index >= animationStateNames.size()) index = animationStateNames.size() - 1;
                     std::cout << "Set animation: " << index <<  " - " << animationStateNames[index] << '\n';
 
-                    m_player.getComponent<AnimationComponent>().playingState = animationStateNames[index];
+                    m_player.getComponent<AnimationComponent>().playingState = index;
                     m_player.getComponent<AnimationComponent>().reset();
                     break;
             }
@@ -72,7 +72,7 @@ void Game::init()
 
     auto& playerAnimaton = m_player.getComponent<AnimationComponent>();
     auto& playerTransform = m_player.addComponent<TransformComponent>().transform;
-    playerTransform.setPosition(m_renderTarget->getView().getSize().x / 2 - playerAnimaton.frameSize.x / 2, m_renderTarget->getView().getSize().y / 2 - playerAnimaton.frameSize.y / 2);
+    playerTransform.setPosition(m_renderTarget->getView().getSize().x / 2 - playerAnimaton.data->frameSize.x / 2, m_renderTarget->getView().getSize().y / 2 - playerAnimaton.data->frameSize.y / 2);
 
     m_player.addComponent<VelocityComponent>();
 
@@ -130,8 +130,8 @@ void Game::onPlayerStateChanged(anax::Entity& e, PlayerComponent::State state)
         auto& animationComp = e.getComponent<AnimationComponent>();
         auto& stateName = stateNames[static_cast<unsigned>(state)];
 
-        auto width = animationComp.frameSize.x;
-        auto height = animationComp.frameSize.y;
+        auto width = animationComp.data->frameSize.x;
+        auto height = animationComp.data->frameSize.y;
 
         spriteComp.sprite.setOrigin(static_cast<unsigned>(0.5 * width), static_cast<unsigned>(0.5 * height)); 
 
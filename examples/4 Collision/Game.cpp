@@ -81,18 +81,18 @@ void Game::init()
     auto& playerCollision = m_player.addComponent<CollisionComponent>();
     playerCollision.causesEvents = true;
     // NOTE: should have this in a file, but this'll do for now
-    playerSprite.setOrigin(playerAnimation.frameSize.x / 2, playerAnimation.frameSize.y / 2);
+    playerSprite.setOrigin(playerAnimation.data->frameSize.x / 2, playerAnimation.data->frameSize.y / 2);
     {
         constexpr int COLLISION_WIDTH = 32;
         constexpr int COLLISION_HEIGHT = 32;
 
-        playerCollision.boundingBox = { (playerAnimation.frameSize.x - COLLISION_WIDTH) / 2 - playerSprite.getOrigin().x, 
-                                        (playerAnimation.frameSize.y - COLLISION_HEIGHT) / 2 - playerSprite.getOrigin().y, 
+        playerCollision.boundingBox = { (playerAnimation.data->frameSize.x - COLLISION_WIDTH) / 2 - playerSprite.getOrigin().x, 
+                                        (playerAnimation.data->frameSize.y - COLLISION_HEIGHT) / 2 - playerSprite.getOrigin().y, 
                                         COLLISION_WIDTH, COLLISION_HEIGHT };
     }
 
     //set player position to be in middle of screen
-    playerTransform.setPosition(m_renderTarget->getView().getSize().x / 2 - playerAnimation.frameSize.x / 2, m_renderTarget->getView().getSize().y / 2 - playerAnimation.frameSize.y / 2);
+    playerTransform.setPosition(m_renderTarget->getView().getSize().x / 2 - playerAnimation.data->frameSize.x / 2, m_renderTarget->getView().getSize().y / 2 - playerAnimation.data->frameSize.y / 2);
 
     m_player.addComponent<VelocityComponent>();
     auto& playerComp = m_player.addComponent<PlayerComponent>();
@@ -111,7 +111,7 @@ void Game::init()
     wallCollision.boundingBox = { { 0, 0 }, { wallSprite.getLocalBounds().width, wallSprite.getLocalBounds().height} };
 
     wallTransform.setPosition(m_renderTarget->getView().getSize().x * 0.75 - wallSprite.getLocalBounds().width / 2, 
-                             (m_renderTarget->getView().getSize().y / 2 - playerAnimation.frameSize.y / 2) - wallCollision.boundingBox.height / 2);
+                             (m_renderTarget->getView().getSize().y / 2 - playerAnimation.data->frameSize.y / 2) - wallCollision.boundingBox.height / 2);
 
     m_player.activate();
     m_wall.activate();
@@ -0,0 +1,177 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless benchmark of components for SIMD operations. Each
+/// component holds eight positions and velocities, which are moved every
+/// tick by a loop the compiler may vectorize. The same component is
+/// measured with its members aligned to 32 bytes (a 256-bit register)
+/// and unaligned, within a CachedSystem of a World and a StaticWorld.
+///
+/// Usage: AlignedComponentBenchmark [ticks] [entity amounts...]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <anax/World.hpp>
+#include <anax/StaticWorld.hpp>
+
+namespace
+{
+    /// Eight positions and velocities, each aligned to a 256-bit register
+    struct AlignedParticles : anax::Component
+    {
+        alignas(32) float positions[8];
+        alignas(32) float velocities[8];
+    };
+
+    /// Eight positions and velocities, only aligned to a float
+    struct UnalignedParticles : anax::Component
+    {
+        float positions[8];
+        float velocities[8];
+    };
+
+    template <class Particles>
+    void move(Particles& particles, float deltaTime)
+    {
+        for(int i = 0; i < 8; ++i)
+        {
+            particles.positions[i] += particles.velocities[i] * deltaTime;
+        }
+    }
+
+    template <class Particles>
+    class Movement : public anax::CachedSystem<anax::Requires<Particles>>
+    {
+    public:
+
+        void update(float deltaTime)
+        {
+            for(auto& tuple : this->getComponentTuples())
+            {
+                move(*std::get<1>(tuple), deltaTime);
+            }
+        }
+    };
+
+    /// \return The time taken to call a function every tick (in ms/tick)
+    template <class Function>
+    double time(std::size_t ticks, Function function)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        auto start = Clock::now();
+        for(std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            function();
+        }
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ticks;
+    }
+
+    template <class Particles>
+    double timeWorld(std::size_t entityAmount, std::size_t ticks)
+    {
+        const float deltaTime = 1 / 60.0f;
+
+        anax::World world;
+        Movement<Particles> movement;
+        world.addSystem(movement);
+
+        for(std::size_t i = 0; i < entityAmount; ++i)
+        {
+            auto entity = world.createEntity();
+            auto& particles = entity.addComponent<Particles>();
+            for(int j = 0; j < 8; ++j)
+            {
+                particles.positions[j] = 0;
+                particles.velocities[j] = static_cast<float>(j);
+            }
+            entity.activate();
+        }
+        world.refresh();
+
+        return time(ticks, [&] { movement.update(deltaTime); });
+    }
+
+    template <class Particles>
+    double timeStaticWorld(std::size_t entityAmount, std::size_t ticks)
+    {
+        const float deltaTime = 1 / 60.0f;
+        typedef anax::StaticWorld<Particles> StaticWorld;
+
+        StaticWorld world(entityAmount);
+        for(std::size_t i = 0; i < entityAmount; ++i)
+        {
+            auto& particles = world.template addComponent<Particles>(world.createEntity());
+            for(int j = 0; j < 8; ++j)
+            {
+                particles.positions[j] = 0;
+                particles.velocities[j] = static_cast<float>(j);
+            }
+        }
+
+        return time(ticks, [&]
+        {
+            world.template forEach<anax::Requires<Particles>>([deltaTime](typename StaticWorld::Id, Particles& particles)
+            {
+                move(particles, deltaTime);
+            });
+        });
+    }
+
+    void runBenchmark(std::size_t entityAmount, std::size_t ticks)
+    {
+        std::cout << entityAmount << " entities: "
+                  << "World (aligned) " << timeWorld<AlignedParticles>(entityAmount, ticks) << " ms/tick, "
+                  << "World (unaligned) " << timeWorld<UnalignedParticles>(entityAmount, ticks) << " ms/tick, "
+                  << "StaticWorld (aligned) " << timeStaticWorld<AlignedParticles>(entityAmount, ticks) << " ms/tick, "
+                  << "StaticWorld (unaligned) " << timeStaticWorld<UnalignedParticles>(entityAmount, ticks) << " ms/tick\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+
+    std::vector<std::size_t> entityAmounts;
+    for(int i = 2; i < argc; ++i)
+    {
+        entityAmounts.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+
+    if(entityAmounts.empty())
+    {
+        entityAmounts = { 10000, 100000, 1000000 };
+    }
+
+    for(auto amount : entityAmounts)
+    {
+        runBenchmark(amount, ticks);
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless benchmark of the AnimationSystem. Every sprite shares the
+/// same animation data, and plays one of its (repeating) states.
+///
+/// The time taken to load the animation data of every sprite is also
+/// measured: parsing the text format per sprite, loading the binary
+/// format per sprite, and sharing the data through an AnimationCache.
+///
+/// Usage: AnimationBenchmark [ticks] [sprite amounts...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <anax/World.hpp>
+
+#include <Assets/AnimationCache.hpp>
+#include <Components/SpriteComponent.hpp>
+#include <Components/AnimationComponent.hpp>
+#include <Systems/AnimationSystem.hpp>
+
+namespace
+{
+    /// The animation data every sprite plays
+    const std::string ANIMATION_DATA_PATH = "resources/meta/playerSpriteSheetFrames.txt";
+
+    /// The binary animation data, written by the benchmark
+    const std::string BINARY_ANIMATION_DATA_PATH = "AnimationBenchmark.anim";
+
+    /// The frame rate of the animation system
+    constexpr unsigned int ANIMATION_FPS = 5;
+
+    template <typename LoadFunction>
+    double timeLoading(std::size_t spriteAmount, LoadFunction load)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        std::vector<AnimationComponent> animations(spriteAmount);
+
+        auto start = Clock::now();
+        for(auto& animation : animations)
+        {
+            load(animation);
+        }
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    void runLoadBenchmark(std::size_t spriteAmount)
+    {
+        auto text = timeLoading(spriteAmount, [](AnimationComponent& animation)
+        {
+            animation.loadData(ANIMATION_DATA_PATH);
+        });
+
+        auto binary = timeLoading(spriteAmount, [](AnimationComponent& animation)
+        {
+            animation.loadData(BINARY_ANIMATION_DATA_PATH);
+        });
+
+        AnimationCache cache;
+        auto cached = timeLoading(spriteAmount, [&cache](AnimationComponent& animation)
+        {
+            animation.data = cache.load(ANIMATION_DATA_PATH);
+        });
+
+        std::cout << spriteAmount << " sprites: load "
+                  << "text " << text << " ms, "
+                  << "binary " << binary << " ms, "
+                  << "cached " << cached << " ms\n";
+    }
+
+    void runBenchmark(std::shared_ptr<const AnimationData> data, std::size_t spriteAmount, std::size_t ticks)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        anax::World world;
+        AnimationSystem animationSystem;
+        animationSystem.setFps(ANIMATION_FPS);
+        world.addSystem(animationSystem);
+
+        auto entities = world.createEntities(spriteAmount);
+        for(std::size_t i = 0; i < entities.size(); ++i)
+        {
+            auto& entity = entities[i];
+            entity.addComponent<SpriteComponent>();
+
+            auto& animation = entity.addComponent<AnimationComponent>();
+            animation.data = data;
+            animation.repeat = true;
+            animation.play(static_cast<AnimationData::StateId>(i % data->states.size()));
+
+            entity.activate();
+        }
+
+        world.refresh();
+
+        auto start = Clock::now();
+        for(std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            animationSystem.update(1 / 60.0);
+        }
+        auto updateTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        std::cout << spriteAmount << " sprites: update " << updateTime / ticks << " ms/tick\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 60;
+
+    std::vector<std::size_t> spriteAmounts;
+    for(int i = 2; i < argc; ++i)
+    {
+        spriteAmounts.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+
+    if(spriteAmounts.empty())
+    {
+        spriteAmounts = { 10000, 50000, 100000 };
+    }
+
+    auto data = std::make_shared<AnimationData>();
+    if(!data->loadData(ANIMATION_DATA_PATH))
+    {
+        std::cerr << "Failed to load animation data\n";
+        return 1;
+    }
+
+    {
+        std::ofstream binary{BINARY_ANIMATION_DATA_PATH, std::ios::binary};
+        if(!data->saveBinary(binary))
+        {
+            std::cerr << "Failed to write binary animation data\n";
+            return 1;
+        }
+    }
+
+    for(auto amount : spriteAmounts)
+    {
+        runLoadBenchmark(amount);
+        runBenchmark(data, amount, ticks);
+    }
+
+    std::remove(BINARY_ANIMATION_DATA_PATH.c_str());
+    return 0;
+}
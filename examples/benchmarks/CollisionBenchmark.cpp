@@ -0,0 +1,194 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless benchmark of the CollisionSystem. Colliders are spread
+/// over an area that grows with the amount of colliders, so the density
+/// of the scene stays the same, and are moved every tick.
+///
+/// Every broadphase is run against two scenes: one where colliders are
+/// spread uniformly, and one where most colliders are clustered within
+/// a few small areas.
+///
+/// Usage: CollisionBenchmark [ticks] [collider amounts...]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <anax/World.hpp>
+
+#include <Components/TransformComponent.hpp>
+#include <Components/CollisionComponent.hpp>
+#include <Systems/CollisionSystem.hpp>
+
+namespace
+{
+    /// The size of every collider
+    constexpr float COLLIDER_SIZE = 32;
+
+    /// The area available to each collider
+    constexpr float AREA_PER_COLLIDER = COLLIDER_SIZE * COLLIDER_SIZE * 16;
+
+    /// The distance a collider moves each tick
+    constexpr float MAX_SPEED = 4;
+
+    /// The amount of clusters within a clustered scene
+    constexpr std::size_t CLUSTER_AMOUNT = 8;
+
+    /// The fraction of colliders within the clusters of a clustered scene
+    constexpr float CLUSTERED_FRACTION = 0.75f;
+
+    enum class Scene
+    {
+        Uniform,
+        Clustered
+    };
+
+    struct CollisionCounter : CollisionSystem::Listener
+    {
+        virtual void onCollisionsOccured(std::vector<CollisionSystem::Collision>& collisions) override
+        {
+            this->collisions += collisions.size();
+        }
+
+        std::size_t collisions = 0;
+    };
+
+    const char* getName(CollisionSystem::Broadphase broadphase)
+    {
+        return broadphase == CollisionSystem::Broadphase::SpatialHash ? "spatial hash" : "sweep and prune";
+    }
+
+    const char* getName(Scene scene)
+    {
+        return scene == Scene::Uniform ? "uniform" : "clustered";
+    }
+
+    void runBenchmark(std::size_t colliderAmount, std::size_t ticks, CollisionSystem::Broadphase broadphase, Scene scene)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        anax::World world;
+        CollisionSystem collisionSystem{broadphase};
+        CollisionCounter counter;
+
+        world.addSystem(collisionSystem);
+        collisionSystem.addListener(counter);
+
+        std::mt19937 random{1234};
+        float worldSize = std::sqrt(AREA_PER_COLLIDER * colliderAmount);
+        std::uniform_real_distribution<float> position{0, worldSize};
+        std::uniform_real_distribution<float> speed{-MAX_SPEED, MAX_SPEED};
+        std::uniform_real_distribution<float> chance{0, 1};
+
+        // clusters are sized to hold their colliders at 4x the density of a uniform scene
+        std::vector<sf::Vector2f> clusters;
+        for(std::size_t i = 0; i < CLUSTER_AMOUNT; ++i)
+        {
+            clusters.emplace_back(position(random), position(random));
+        }
+
+        float clusterSize = std::sqrt(AREA_PER_COLLIDER * colliderAmount * CLUSTERED_FRACTION / CLUSTER_AMOUNT) / 2;
+        std::uniform_real_distribution<float> clusterOffset{-clusterSize / 2, clusterSize / 2};
+        std::uniform_int_distribution<std::size_t> cluster{0, CLUSTER_AMOUNT - 1};
+
+        std::vector<sf::Vector2f> velocities;
+        velocities.reserve(colliderAmount);
+
+        auto entities = world.createEntities(colliderAmount);
+        for(auto& entity : entities)
+        {
+            auto& transform = entity.addComponent<TransformComponent>().transform;
+            if(scene == Scene::Clustered && chance(random) < CLUSTERED_FRACTION)
+            {
+                auto& center = clusters[cluster(random)];
+                transform.setPosition(center.x + clusterOffset(random), center.y + clusterOffset(random));
+            }
+            else
+            {
+                transform.setPosition(position(random), position(random));
+            }
+
+            auto& collision = entity.addComponent<CollisionComponent>();
+            collision.boundingBox = sf::FloatRect(0, 0, COLLIDER_SIZE, COLLIDER_SIZE);
+            collision.causesEvents = true;
+
+            velocities.emplace_back(speed(random), speed(random));
+            entity.activate();
+        }
+
+        auto start = Clock::now();
+        world.refresh();
+        auto refreshTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        double updateTime = 0;
+        for(std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            for(std::size_t i = 0; i < entities.size(); ++i)
+            {
+                entities[i].getComponent<TransformComponent>().transform.move(velocities[i]);
+            }
+
+            start = Clock::now();
+            collisionSystem.update(1 / 60.0);
+            updateTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        std::cout << colliderAmount << " colliders (" << getName(broadphase) << ", " << getName(scene) << "): "
+                  << "refresh " << refreshTime << " ms, "
+                  << "update " << updateTime / ticks << " ms/tick, "
+                  << counter.collisions / ticks << " collisions/tick\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 60;
+
+    std::vector<std::size_t> colliderAmounts;
+    for(int i = 2; i < argc; ++i)
+    {
+        colliderAmounts.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+
+    if(colliderAmounts.empty())
+    {
+        colliderAmounts = { 10000, 25000, 50000, 100000 };
+    }
+
+    for(auto scene : { Scene::Uniform, Scene::Clustered })
+    {
+        for(auto amount : colliderAmounts)
+        {
+            runBenchmark(amount, ticks, CollisionSystem::Broadphase::SpatialHash, scene);
+            runBenchmark(amount, ticks, CollisionSystem::Broadphase::SweepAndPrune, scene);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless benchmark of compacting a World. Many entities are created
+/// and most of them are killed at random, leaving the alive entities
+/// spread over a large range of indices. The entities are moved by a
+/// system before and after calling World::compact.
+///
+/// Usage: CompactionBenchmark [ticks] [entity amount] [percentage of entities kept alive]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <anax/World.hpp>
+
+namespace
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    struct Position : anax::Component
+    {
+        float x = 0;
+        float y = 0;
+    };
+
+    struct Velocity : anax::Component
+    {
+        float x = 1;
+        float y = 1;
+    };
+
+    class Movement : public anax::System<anax::Requires<Position, Velocity>>
+    {
+    public:
+
+        void update(float deltaTime)
+        {
+            for(auto& entity : getEntities())
+            {
+                auto& position = entity.getComponent<Position>();
+                auto& velocity = entity.getComponent<Velocity>();
+                position.x += velocity.x * deltaTime;
+                position.y += velocity.y * deltaTime;
+            }
+        }
+    };
+
+    double toMs(Clock::duration time)
+    {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+
+    /// \return The time taken to move the entities (in ms/tick)
+    double timeUpdate(Movement& movement, std::size_t ticks)
+    {
+        auto start = Clock::now();
+        for(std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            movement.update(1 / 60.0f);
+        }
+        return toMs(Clock::now() - start) / ticks;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    std::size_t entityAmount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500000;
+    std::size_t alivePercentage = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10;
+
+    anax::World world(entityAmount);
+    Movement movement;
+    world.addSystem(movement);
+
+    std::mt19937 random{42};
+    std::uniform_int_distribution<std::size_t> percentage{0, 99};
+    for(std::size_t i = 0; i < entityAmount; ++i)
+    {
+        auto entity = world.createEntity();
+        entity.addComponent<Position>();
+        entity.addComponent<Velocity>();
+        entity.activate();
+        if(percentage(random) >= alivePercentage)
+        {
+            entity.kill();
+        }
+    }
+    world.refresh();
+
+    std::cout << world.getEntityCount() << " of " << entityAmount << " entities alive\n";
+    std::cout << "before compacting: update " << timeUpdate(movement, ticks) << " ms/tick\n";
+
+    auto start = Clock::now();
+    auto remap = world.compact();
+    auto compactTime = toMs(Clock::now() - start);
+
+    std::cout << "compact: " << compactTime << " ms, " << remap.getMoves().size() << " entities moved\n";
+    std::cout << "after compacting: update " << timeUpdate(movement, ticks) << " ms/tick\n";
+
+    return 0;
+}
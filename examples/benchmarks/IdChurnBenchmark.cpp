@@ -0,0 +1,173 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless benchmark of worlds which kill and create many entities
+/// every tick (e.g. bullets or particles), for each policy of re-using
+/// the indices of killed entities. Every tick a random selection of the
+/// entities is killed and replaced, the world is refreshed and the
+/// entities are moved by a system, which keeps its entities either in
+/// the order they were activated or sorted by index.
+///
+/// Usage: IdChurnBenchmark [ticks] [entity amount] [entities replaced per tick]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <anax/World.hpp>
+
+namespace
+{
+    struct Position : anax::Component
+    {
+        float x = 0;
+        float y = 0;
+    };
+
+    struct Velocity : anax::Component
+    {
+        float x = 1;
+        float y = 1;
+    };
+
+    class Movement : public anax::System<anax::Requires<Position, Velocity>>
+    {
+    public:
+
+        void update(float deltaTime)
+        {
+            for(auto& entity : getEntities())
+            {
+                auto& position = entity.getComponent<Position>();
+                auto& velocity = entity.getComponent<Velocity>();
+                position.x += velocity.x * deltaTime;
+                position.y += velocity.y * deltaTime;
+            }
+        }
+    };
+
+    struct Policy
+    {
+        const char* name;
+        anax::EntityIdRecycling recycling;
+    };
+
+    anax::Entity createMovingEntity(anax::World& world)
+    {
+        auto entity = world.createEntity();
+        entity.addComponent<Position>();
+        entity.addComponent<Velocity>();
+        entity.activate();
+        return entity;
+    }
+
+    void runBenchmark(const Policy& policy, Movement::EntityOrder order, std::size_t ticks, std::size_t entityAmount, std::size_t churn)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+        const float deltaTime = 1 / 60.0f;
+
+        anax::World world(entityAmount, anax::EntityIdLayout{}, policy.recycling);
+        Movement movement;
+        movement.setEntityOrder(order);
+        world.addSystem(movement);
+
+        std::vector<anax::Entity> entities;
+        entities.reserve(entityAmount);
+        for(std::size_t i = 0; i < entityAmount; ++i)
+        {
+            entities.push_back(createMovingEntity(world));
+        }
+        world.refresh();
+
+        // the same entities are replaced for every policy
+        std::mt19937 random{42};
+        Clock::duration churnTime{}, refreshTime{}, updateTime{};
+        for(std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            auto start = Clock::now();
+            for(std::size_t i = 0; i < churn; ++i)
+            {
+                auto& entity = entities[std::uniform_int_distribution<std::size_t>{0, entities.size() - 1}(random)];
+                entity.kill();
+                entity = createMovingEntity(world);
+            }
+
+            auto refreshStart = Clock::now();
+            world.refresh();
+
+            auto updateStart = Clock::now();
+            movement.update(deltaTime);
+
+            auto end = Clock::now();
+            churnTime += refreshStart - start;
+            refreshTime += updateStart - refreshStart;
+            updateTime += end - updateStart;
+        }
+
+        std::size_t indexCount = 0;
+        anax::Entity::Id::int_type maxCounter = 0;
+        for(auto& entity : entities)
+        {
+            indexCount = std::max<std::size_t>(indexCount, entity.getId().index + 1);
+            maxCounter = std::max<anax::Entity::Id::int_type>(maxCounter, entity.getId().counter);
+        }
+
+        auto toMs = [ticks](Clock::duration time) { return std::chrono::duration<double, std::milli>(time).count() / ticks; };
+        std::cout << policy.name << (order == Movement::EntityOrder::INDEX ? " (sorted by index)" : "") << ": "
+                  << "kill/create " << toMs(churnTime) << " ms/tick, "
+                  << "refresh " << toMs(refreshTime) << " ms/tick, "
+                  << "update " << toMs(updateTime) << " ms/tick, "
+                  << "indices used " << indexCount << ", "
+                  << "highest counter " << maxCounter << "\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    std::size_t entityAmount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+    std::size_t churn = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : entityAmount / 100;
+
+    std::cout << entityAmount << " entities, " << churn << " replaced per tick, " << ticks << " ticks\n";
+
+    const Policy policies[] =
+    {
+        { "LIFO", anax::EntityIdRecycling{anax::EntityIdRecyclingOrder::LIFO} },
+        { "FIFO", anax::EntityIdRecycling{anax::EntityIdRecyclingOrder::FIFO} },
+        { "FIFO (quarantine of 1024)", anax::EntityIdRecycling{anax::EntityIdRecyclingOrder::FIFO, 1024} },
+        { "Lowest index first", anax::EntityIdRecycling{anax::EntityIdRecyclingOrder::LOWEST_INDEX_FIRST} }
+    };
+
+    for(auto& policy : policies)
+    {
+        runBenchmark(policy, Movement::EntityOrder::ACTIVATION, ticks, entityAmount, churn);
+        runBenchmark(policy, Movement::EntityOrder::INDEX, ticks, entityAmount, churn);
+    }
+
+    return 0;
+}
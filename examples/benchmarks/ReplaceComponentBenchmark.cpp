@@ -0,0 +1,121 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless benchmark of overwriting components, as done when
+/// applying replicated state received over a network. Every tick each
+/// entity receives a new snapshot of its replicated component, which is
+/// written with addComponent (destroying the old component and
+/// constructing a new one at another address) or emplaceOrReplace
+/// (assigning the snapshot to the existing component).
+///
+/// Usage: ReplaceComponentBenchmark [ticks] [entity amounts...]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <anax/World.hpp>
+
+namespace
+{
+    /// The state of an entity replicated from a server
+    struct ReplicatedComponent : anax::Component
+    {
+        float position[3];
+        float velocity[3];
+        std::string owner;
+    };
+
+    /// \return The time taken to overwrite the component of every entity (in ms/tick)
+    template <class Overwrite>
+    double time(std::size_t entityAmount, std::size_t ticks, Overwrite overwrite)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        anax::World world;
+        auto entities = world.createEntities(entityAmount);
+
+        // the snapshots received from the server
+        std::vector<ReplicatedComponent> snapshots(entityAmount);
+        for(std::size_t i = 0; i < entityAmount; ++i)
+        {
+            snapshots[i].owner = "player with a long name " + std::to_string(i % 16);
+            entities[i].addComponent<ReplicatedComponent>(snapshots[i]);
+        }
+
+        auto start = Clock::now();
+        for(std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            for(std::size_t i = 0; i < entityAmount; ++i)
+            {
+                snapshots[i].position[0] += 1;
+                overwrite(entities[i], snapshots[i]);
+            }
+        }
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ticks;
+    }
+
+    void runBenchmark(std::size_t entityAmount, std::size_t ticks)
+    {
+        auto add = time(entityAmount, ticks, [](anax::Entity& entity, const ReplicatedComponent& snapshot)
+        {
+            entity.addComponent<ReplicatedComponent>(snapshot);
+        });
+
+        auto replace = time(entityAmount, ticks, [](anax::Entity& entity, const ReplicatedComponent& snapshot)
+        {
+            entity.emplaceOrReplace<ReplicatedComponent>(snapshot);
+        });
+
+        std::cout << entityAmount << " entities: "
+                  << "addComponent " << add << " ms/tick, "
+                  << "emplaceOrReplace " << replace << " ms/tick\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+
+    std::vector<std::size_t> entityAmounts;
+    for(int i = 2; i < argc; ++i)
+    {
+        entityAmounts.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+
+    if(entityAmounts.empty())
+    {
+        entityAmounts = { 1000, 10000, 100000 };
+    }
+
+    for(auto amount : entityAmounts)
+    {
+        runBenchmark(amount, ticks);
+    }
+
+    return 0;
+}
@@ -0,0 +1,325 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless simulation of the example systems. A world is populated
+/// with entities made of the example components, which are moved,
+/// animated and collided at a fixed timestep without any rendering. A
+/// small fraction of the entities are killed and replaced every tick,
+/// so that World::refresh has work to do.
+///
+/// The time spent within each system per tick and the memory used by
+/// the world are written as JSON to the standard output, so that runs of
+/// different versions of anax can be compared. If anax is built with
+/// ANAX_ENABLE_STATS, the statistics of the world (e.g. the time spent
+/// within each phase of a refresh) are written as well. If anax is built
+/// with ANAX_ENABLE_TRACING, a timeline of the simulation may be written
+/// to a trace event file, which can be opened with chrome://tracing or
+/// Perfetto.
+///
+/// Usage: SimulationBenchmark [entities] [ticks] [respawns per tick] [trace file]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <anax/World.hpp>
+
+#include <Assets/AnimationData.hpp>
+#include <Components/AnimationComponent.hpp>
+#include <Components/CollisionComponent.hpp>
+#include <Components/SpriteComponent.hpp>
+#include <Components/TransformComponent.hpp>
+#include <Components/VelocityComponent.hpp>
+#include <Systems/AnimationSystem.hpp>
+#include <Systems/CollisionSystem.hpp>
+#include <Systems/MovementSystem.hpp>
+
+namespace
+{
+    /// The animation data every entity plays
+    const std::string ANIMATION_DATA_PATH = "resources/meta/playerSpriteSheetFrames.txt";
+
+    /// The fixed timestep of the simulation
+    constexpr double TIMESTEP = 1 / 60.0;
+
+    /// The frame rate of the animation system
+    constexpr unsigned int ANIMATION_FPS = 5;
+
+    /// The size of every collider
+    constexpr float COLLIDER_SIZE = 32;
+
+    /// The area available to each entity
+    constexpr float AREA_PER_ENTITY = COLLIDER_SIZE * COLLIDER_SIZE * 16;
+
+    /// The maximum speed of an entity, in units per second
+    constexpr float MAX_SPEED = 120;
+
+    /// Accumulates the time taken by a part of the simulation
+    struct Timing
+    {
+        Timing(const char* name) : name(name), total(0), min(std::numeric_limits<double>::max()), max(0) {}
+
+        void add(double milliseconds)
+        {
+            total += milliseconds;
+            min = std::min(min, milliseconds);
+            max = std::max(max, milliseconds);
+        }
+
+        const char* name;
+        double total;
+        double min;
+        double max;
+    };
+
+    /// Times a function, adding the time taken to a timing
+    template <typename Function>
+    void time(Timing& timing, Function function)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        auto start = Clock::now();
+        function();
+        timing.add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    struct CollisionCounter : CollisionSystem::Listener
+    {
+        virtual void onCollisionsOccured(std::vector<CollisionSystem::Collision>& collisions) override
+        {
+            this->collisions += collisions.size();
+        }
+
+        std::size_t collisions = 0;
+    };
+
+    /// Spawns the entities of the simulation
+    class Spawner
+    {
+    public:
+
+        Spawner(anax::World& world, std::shared_ptr<const AnimationData> animationData, float worldSize) :
+            m_world(world),
+            m_animationData(animationData),
+            m_random(1234),
+            m_position(0, worldSize),
+            m_speed(-MAX_SPEED, MAX_SPEED)
+        {
+        }
+
+        anax::Entity spawn()
+        {
+            auto entity = m_world.createEntity();
+
+            entity.addComponent<TransformComponent>().transform.setPosition(m_position(m_random), m_position(m_random));
+            entity.addComponent<VelocityComponent>().velocity = sf::Vector2f(m_speed(m_random), m_speed(m_random));
+            entity.addComponent<SpriteComponent>();
+
+            auto& animation = entity.addComponent<AnimationComponent>();
+            animation.data = m_animationData;
+            animation.repeat = true;
+            animation.play(static_cast<AnimationData::StateId>(m_random() % m_animationData->states.size()));
+
+            auto& collision = entity.addComponent<CollisionComponent>();
+            collision.boundingBox = sf::FloatRect(0, 0, COLLIDER_SIZE, COLLIDER_SIZE);
+            collision.causesEvents = true;
+
+            entity.activate();
+            return entity;
+        }
+
+        std::size_t pick(std::size_t amount)
+        {
+            return m_random() % amount;
+        }
+
+    private:
+
+        anax::World& m_world;
+        std::shared_ptr<const AnimationData> m_animationData;
+        std::mt19937 m_random;
+        std::uniform_real_distribution<float> m_position;
+        std::uniform_real_distribution<float> m_speed;
+    };
+
+    void writeTiming(const Timing& timing, std::size_t ticks, bool isLast)
+    {
+        std::cout << "    \"" << timing.name << "\": { "
+                  << "\"mean_ms\": " << timing.total / ticks << ", "
+                  << "\"min_ms\": " << timing.min << ", "
+                  << "\"max_ms\": " << timing.max << ", "
+                  << "\"total_ms\": " << timing.total << " }"
+                  << (isLast ? "\n" : ",\n");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t entityAmount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000;
+    std::size_t ticks = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 600;
+    std::size_t respawnsPerTick = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : entityAmount / 1000;
+
+    if(entityAmount == 0 || ticks == 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " [entities] [ticks] [respawns per tick] [trace file]\n";
+        return 1;
+    }
+
+    auto animationData = std::make_shared<AnimationData>();
+    if(!animationData->loadData(ANIMATION_DATA_PATH))
+    {
+        std::cerr << "Failed to load animation data\n";
+        return 1;
+    }
+
+    anax::World world;
+
+#ifdef ANAX_ENABLE_TRACING
+    std::unique_ptr<anax::util::TraceRecorder> traceRecorder;
+    if(argc > 4)
+    {
+        traceRecorder.reset(new anax::util::TraceRecorder(argv[4]));
+        traceRecorder->setThreadName("simulation");
+        world.setTraceRecorder(traceRecorder.get());
+    }
+#else
+    if(argc > 4)
+    {
+        std::cerr << "Tracing is not enabled, anax must be built with ANAX_ENABLE_TRACING\n";
+    }
+#endif // ANAX_ENABLE_TRACING
+
+    MovementSystem movementSystem;
+    AnimationSystem animationSystem;
+    CollisionSystem collisionSystem;
+    CollisionCounter collisionCounter;
+
+    animationSystem.setFps(ANIMATION_FPS);
+    collisionSystem.addListener(collisionCounter);
+
+    world.addSystem(movementSystem);
+    world.addSystem(animationSystem);
+    world.addSystem(collisionSystem);
+
+    Spawner spawner(world, animationData, std::sqrt(AREA_PER_ENTITY * entityAmount));
+
+    std::vector<anax::Entity> entities;
+    entities.reserve(entityAmount);
+    for(std::size_t i = 0; i < entityAmount; ++i)
+    {
+        entities.push_back(spawner.spawn());
+    }
+
+    world.refresh();
+
+    Timing refreshTiming("refresh");
+    Timing movementTiming("MovementSystem");
+    Timing animationTiming("AnimationSystem");
+    Timing collisionTiming("CollisionSystem");
+    Timing tickTiming("tick");
+
+    for(std::size_t tick = 0; tick < ticks; ++tick)
+    {
+        time(tickTiming, [&]
+        {
+#ifdef ANAX_ENABLE_TRACING
+            anax::util::TraceRecorder::Scope traceScope{traceRecorder.get(), "tick"};
+#endif // ANAX_ENABLE_TRACING
+
+            // replace a few entities, as a game would
+            for(std::size_t i = 0; i < respawnsPerTick; ++i)
+            {
+                auto& entity = entities[spawner.pick(entities.size())];
+                entity.kill();
+                entity = spawner.spawn();
+            }
+
+            time(refreshTiming, [&] { world.refresh(); });
+            time(movementTiming, [&] { world.updateSystem(movementSystem, TIMESTEP); });
+            time(animationTiming, [&] { world.updateSystem(animationSystem, TIMESTEP); });
+            time(collisionTiming, [&] { world.updateSystem(collisionSystem, TIMESTEP); });
+        });
+    }
+
+    std::cout << "{\n"
+              << "  \"entities\": " << entityAmount << ",\n"
+              << "  \"ticks\": " << ticks << ",\n"
+              << "  \"timestep\": " << TIMESTEP << ",\n"
+              << "  \"respawns_per_tick\": " << respawnsPerTick << ",\n"
+              << "  \"collisions_per_tick\": " << collisionCounter.collisions / ticks << ",\n"
+              << "  \"systems\": {\n";
+
+    writeTiming(refreshTiming, ticks, false);
+    writeTiming(movementTiming, ticks, false);
+    writeTiming(animationTiming, ticks, false);
+    writeTiming(collisionTiming, ticks, false);
+    writeTiming(tickTiming, ticks, true);
+
+    auto memory = world.getMemoryReport();
+    auto memoryTotal = memory.getTotal();
+    std::cout << "  },\n"
+              << "  \"memory\": {\n"
+              << "    \"used_bytes\": " << memoryTotal.usedBytes << ",\n"
+              << "    \"reserved_bytes\": " << memoryTotal.reservedBytes << ",\n"
+              << "    \"reserved_bytes_per_entity\": " << memoryTotal.reservedBytes / world.getEntityCount() << ",\n"
+              << "    \"component_entries_bytes\": " << memory.componentEntries.reservedBytes << ",\n"
+              << "    \"entity_attributes_bytes\": " << memory.entityAttributes.reservedBytes << "\n"
+              << "  }";
+
+#ifdef ANAX_ENABLE_STATS
+    // the statistics include the refresh that populated the world
+    auto& stats = world.getStats().totalRefresh;
+    auto refreshCount = world.getStats().refreshCount;
+    auto toMilliseconds = [refreshCount](anax::WorldStats::Duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count() / refreshCount;
+    };
+
+    std::cout << ",\n"
+              << "  \"refresh_stats\": {\n"
+              << "    \"refreshes\": " << refreshCount << ",\n"
+              << "    \"activated_ms\": " << toMilliseconds(stats.activatedTime) << ",\n"
+              << "    \"deactivated_ms\": " << toMilliseconds(stats.deactivatedTime) << ",\n"
+              << "    \"killed_ms\": " << toMilliseconds(stats.killedTime) << ",\n"
+              << "    \"activated\": " << stats.activatedCount << ",\n"
+              << "    \"deactivated\": " << stats.deactivatedCount << ",\n"
+              << "    \"killed\": " << stats.killedCount << ",\n"
+              << "    \"filter_checks\": " << stats.filterChecks << ",\n"
+              << "    \"system_adds\": " << stats.systemAdds << ",\n"
+              << "    \"system_removes\": " << stats.systemRemoves << "\n"
+              << "  }";
+#endif // ANAX_ENABLE_STATS
+
+    std::cout << "\n}\n";
+
+    return 0;
+}
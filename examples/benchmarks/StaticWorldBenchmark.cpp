@@ -0,0 +1,247 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// A headless benchmark of iterating over components within a World and
+/// a StaticWorld. Entities are moved by their velocity every tick, by a
+/// system of the World, by a CachedSystem of the World, by
+/// StaticWorld::forEach and by a loop over the columns of components
+/// stored within columns of a StaticWorld. A quarter of the entities
+/// have no velocity, so each must filter the entities; the columns are
+/// also moved with every entity having a velocity.
+///
+/// Usage: StaticWorldBenchmark [ticks] [entity amounts...]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <anax/World.hpp>
+#include <anax/StaticWorld.hpp>
+
+namespace
+{
+    struct Position : anax::Component
+    {
+        float x = 0;
+        float y = 0;
+    };
+
+    struct Velocity : anax::Component
+    {
+        float x = 0;
+        float y = 0;
+    };
+
+    typedef anax::StaticWorld<Position, Velocity> StaticWorld;
+
+    struct ColumnPosition : anax::Component
+    {
+        float x = 0;
+        float y = 0;
+    };
+
+    struct ColumnVelocity : anax::Component
+    {
+        float x = 0;
+        float y = 0;
+    };
+
+    typedef anax::StaticWorld<ColumnPosition, ColumnVelocity> ColumnWorld;
+}
+
+namespace anax
+{
+    template <>
+    struct ComponentColumns<ColumnPosition> : Columns<ColumnPosition, float, &ColumnPosition::x, &ColumnPosition::y> {};
+
+    template <>
+    struct ComponentColumns<ColumnVelocity> : Columns<ColumnVelocity, float, &ColumnVelocity::x, &ColumnVelocity::y> {};
+}
+
+namespace
+{
+    class Movement : public anax::System<anax::Requires<Position, Velocity>>
+    {
+    public:
+
+        void update(float deltaTime)
+        {
+            for(auto& entity : getEntities())
+            {
+                auto& position = entity.getComponent<Position>();
+                auto& velocity = entity.getComponent<Velocity>();
+                position.x += velocity.x * deltaTime;
+                position.y += velocity.y * deltaTime;
+            }
+        }
+    };
+
+    class CachedMovement : public anax::CachedSystem<anax::Requires<Position, Velocity>>
+    {
+    public:
+
+        void update(float deltaTime)
+        {
+            for(auto& tuple : getComponentTuples())
+            {
+                auto& position = *std::get<1>(tuple);
+                auto& velocity = *std::get<2>(tuple);
+                position.x += velocity.x * deltaTime;
+                position.y += velocity.y * deltaTime;
+            }
+        }
+    };
+
+    void move(StaticWorld& world, float deltaTime)
+    {
+        world.forEach<anax::Requires<Position, Velocity>>([deltaTime](StaticWorld::Id, Position& position, Velocity& velocity)
+        {
+            position.x += velocity.x * deltaTime;
+            position.y += velocity.y * deltaTime;
+        });
+    }
+
+    void move(ColumnWorld& world, float deltaTime)
+    {
+        auto positionX = world.getColumn(&ColumnPosition::x).data();
+        auto positionY = world.getColumn(&ColumnPosition::y).data();
+        auto velocityX = world.getColumn(&ColumnVelocity::x).data();
+        auto velocityY = world.getColumn(&ColumnVelocity::y).data();
+
+        world.forEachRange<anax::Requires<ColumnPosition, ColumnVelocity>>([=](std::size_t begin, std::size_t end)
+        {
+            for(auto i = begin; i < end; ++i)
+            {
+                positionX[i] += velocityX[i] * deltaTime;
+                positionY[i] += velocityY[i] * deltaTime;
+            }
+        });
+    }
+
+    /// \return The time taken to call a function every tick (in ms/tick)
+    template <class Function>
+    double time(std::size_t ticks, Function function)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        auto start = Clock::now();
+        for(std::size_t tick = 0; tick < ticks; ++tick)
+        {
+            function();
+        }
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / ticks;
+    }
+
+    /// \param hasVelocity Determines if an entity has a velocity
+    /// \return The time taken to move the columns every tick (in ms/tick)
+    template <class HasVelocity>
+    double timeColumns(std::size_t entityAmount, std::size_t ticks, HasVelocity hasVelocity)
+    {
+        const float deltaTime = 1 / 60.0f;
+
+        ColumnWorld world;
+        for(std::size_t i = 0; i < entityAmount; ++i)
+        {
+            auto entity = world.createEntity();
+            world.addComponent<ColumnPosition>(entity);
+            if(hasVelocity(i))
+            {
+                ColumnVelocity velocity;
+                velocity.x = 1;
+                world.addComponent<ColumnVelocity>(entity, velocity);
+            }
+        }
+
+        return time(ticks, [&] { move(world, deltaTime); });
+    }
+
+    void runBenchmark(std::size_t entityAmount, std::size_t ticks)
+    {
+        const float deltaTime = 1 / 60.0f;
+
+        anax::World world;
+        Movement movement;
+        CachedMovement cachedMovement;
+        world.addSystem(movement);
+        world.addSystem(cachedMovement);
+
+        StaticWorld staticWorld;
+
+        for(std::size_t i = 0; i < entityAmount; ++i)
+        {
+            auto entity = world.createEntity();
+            auto staticEntity = staticWorld.createEntity();
+
+            entity.addComponent<Position>();
+            staticWorld.addComponent<Position>(staticEntity);
+            if(i % 4 != 0)
+            {
+                entity.addComponent<Velocity>().x = 1;
+                staticWorld.addComponent<Velocity>(staticEntity).x = 1;
+            }
+
+            entity.activate();
+        }
+
+        world.refresh();
+
+        auto worldTime = time(ticks, [&] { movement.update(deltaTime); });
+        auto cachedWorldTime = time(ticks, [&] { cachedMovement.update(deltaTime); });
+        auto staticWorldTime = time(ticks, [&] { move(staticWorld, deltaTime); });
+        auto columnsTime = timeColumns(entityAmount, ticks, [](std::size_t i) { return i % 4 != 0; });
+        auto denseColumnsTime = timeColumns(entityAmount, ticks, [](std::size_t) { return true; });
+
+        std::cout << entityAmount << " entities: "
+                  << "World " << worldTime << " ms/tick, "
+                  << "World (cached components) " << cachedWorldTime << " ms/tick, "
+                  << "StaticWorld " << staticWorldTime << " ms/tick, "
+                  << "StaticWorld (columns) " << columnsTime << " ms/tick, "
+                  << "StaticWorld (columns, every entity moving) " << denseColumnsTime << " ms/tick\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+
+    std::vector<std::size_t> entityAmounts;
+    for(int i = 2; i < argc; ++i)
+    {
+        entityAmounts.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+
+    if(entityAmounts.empty())
+    {
+        entityAmounts = { 10000, 100000, 1000000 };
+    }
+
+    for(auto amount : entityAmounts)
+    {
+        runBenchmark(amount, ticks);
+    }
+
+    return 0;
+}
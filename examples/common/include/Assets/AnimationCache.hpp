@@ -0,0 +1,60 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_EXAMPLES_COMMON_ASSETS_ANIMATIONCACHE_HPP
+#define ANAX_EXAMPLES_COMMON_ASSETS_ANIMATIONCACHE_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <Assets/AnimationData.hpp>
+
+/// \brief A cache of animation data, keyed by filepath
+///
+/// Each file is loaded once, and its data is shared between every
+/// AnimationComponent that plays it.
+///
+/// \author Miguel Martin
+class AnimationCache
+{
+public:
+
+    /// Retrieves the animation data of a file, loading it if necessary
+    /// \param filepath The filepath to the file, of either format
+    /// \return The animation data, or nullptr if the file failed to load
+    std::shared_ptr<const AnimationData> load(const std::string& filepath);
+
+    /// Removes all animation data from the cache
+    /// \note Components that are playing the data keep it alive
+    void clear() { m_data.clear(); }
+
+private:
+
+    /// The animation data that has been loaded
+    std::map<std::string, std::shared_ptr<const AnimationData>> m_data;
+};
+
+#endif // ANAX_EXAMPLES_COMMON_ASSETS_ANIMATIONCACHE_HPP
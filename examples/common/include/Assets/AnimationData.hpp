@@ -0,0 +1,133 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_EXAMPLES_COMMON_ASSETS_ANIMATIONDATA_HPP
+#define ANAX_EXAMPLES_COMMON_ASSETS_ANIMATIONDATA_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+/// \brief Animation data, compiled for playback
+///
+/// The names of the states of an animation are interned to integer IDs
+/// when the data is loaded, and the frames of every state are laid out
+/// within a single flat array. Playing an animation is thus indexing
+/// into arrays, without any look ups by name.
+///
+/// This data is immutable once loaded, and is meant to be shared by
+/// every AnimationComponent that plays it (see AnimationCache).
+///
+/// Animation data may be loaded from a text format, or from a versioned
+/// binary format, which is the compiled data written out as is. The
+/// binary format is little-endian, and is laid out as follows:
+///
+///     "ANXA"                          magic
+///     u32                             version
+///     u32 u32                         frame width, frame height
+///     u32                             state count
+///     u32                             frame count
+///     state count * {
+///         u32 u32 u32                 first frame, frame count, frame rate
+///         u32 char[]                  name length, name
+///     }
+///     frame count * { i32 i32 i32 i32 }  frame rectangles
+///
+/// \author Miguel Martin
+struct AnimationData
+{
+    /// Describes the ID of a state, this is the index of the state
+    typedef std::uint32_t StateId;
+
+    /// Describes a state that does not exist
+    static constexpr StateId INVALID_STATE = static_cast<StateId>(-1);
+
+    struct State
+    {
+        /// The index of the first frame of the state within frames
+        std::uint32_t firstFrame;
+
+        /// The amount of frames within the state
+        std::uint32_t frameCount;
+
+        /// The frame rate the state is played at, if this is 0
+        /// the animation system's frame rate is used
+        unsigned int frameRate;
+    };
+
+    /// The version of the binary format that is written
+    static constexpr std::uint32_t BINARY_VERSION = 1;
+
+    /// Loads (and compiles) animation data from a stream of the text format
+    /// \param stream The stream you wish to load data from
+    /// \return true if the data was loaded successfully
+    bool loadData(std::istream& stream);
+
+    /// Loads animation data from a filepath, of either format
+    /// \param filepath The filepath to the file you wish to load data from
+    /// \return true if the data was loaded successfully
+    /// \note The file is memory mapped whilst it is loaded
+    bool loadData(const std::string& filepath);
+
+    /// Loads animation data from memory of the binary format
+    /// \param data The binary data
+    /// \param size The size of the data, in bytes
+    /// \return true if the data was loaded successfully
+    bool loadBinary(const char* data, std::size_t size);
+
+    /// Writes the animation data in the binary format
+    /// \param stream The stream you wish to write the data to
+    /// \return true if the data was written successfully
+    bool saveBinary(std::ostream& stream) const;
+
+    /// \param data The data you wish to check
+    /// \param size The size of the data, in bytes
+    /// \return true if the data is of the binary format
+    static bool IsBinary(const char* data, std::size_t size);
+
+    /// Retrieves the ID of a state
+    /// \param name The name of the state
+    /// \return The ID of the state, or INVALID_STATE if there is no such state
+    StateId getStateId(const std::string& name) const;
+
+    /// The size of each frame
+    sf::Vector2u frameSize;
+
+    /// The states of the animation, indexed by their ID
+    std::vector<State> states;
+
+    /// The names of the states, indexed by their ID
+    std::vector<std::string> stateNames;
+
+    /// The texture rectangle of every frame, of every state
+    std::vector<sf::IntRect> frames;
+};
+
+#endif // ANAX_EXAMPLES_COMMON_ASSETS_ANIMATIONDATA_HPP
@@ -0,0 +1,85 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_EXAMPLES_COMMON_ASSETS_MAPPEDFILE_HPP
+#define ANAX_EXAMPLES_COMMON_ASSETS_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/// \brief A read-only memory mapping of a file
+///
+/// The contents of the file are paged in by the operating system as
+/// they are read, rather than being copied into a buffer up front.
+///
+/// \author Miguel Martin
+class MappedFile
+{
+public:
+
+    MappedFile();
+
+    /// Maps a file into memory
+    /// \param filepath The filepath to the file you wish to map
+    explicit MappedFile(const std::string& filepath);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    /// Maps a file into memory, unmapping the file currently mapped
+    /// \param filepath The filepath to the file you wish to map
+    /// \return true if the file was mapped successfully
+    /// \note An empty file is opened successfully, with no data
+    bool open(const std::string& filepath);
+
+    /// Unmaps the file currently mapped
+    void close();
+
+    /// \return true if a file is mapped
+    bool isOpen() const { return m_data != nullptr; }
+
+    /// \return The contents of the file, which is never null while open
+    const char* getData() const { return m_data; }
+
+    /// \return The size of the file, in bytes
+    std::size_t getSize() const { return m_size; }
+
+private:
+
+    /// The contents of the file
+    const char* m_data;
+
+    /// The size of the file
+    std::size_t m_size;
+
+#ifdef _WIN32
+    /// The handle of the file mapping
+    void* m_mapping;
+#endif // _WIN32
+};
+
+#endif // ANAX_EXAMPLES_COMMON_ASSETS_MAPPEDFILE_HPP
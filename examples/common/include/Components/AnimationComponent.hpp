@@ -26,18 +26,21 @@
 #ifndef ANAX_EXAMPLES_COMMON_COMPONENTS_ANIMATIONCOMPONENT_HPP
 #define ANAX_EXAMPLES_COMMON_COMPONENTS_ANIMATIONCOMPONENT_HPP
 
-#include <fstream>
-#include <vector>
-#include <map>
+#include <memory>
+#include <string>
 
 #include <anax/Component.hpp>
 #include <anax/Config.hpp>
-#include <SFML/Graphics/Sprite.hpp>
 
+#include <Assets/AnimationData.hpp>
 
 struct AnimationSystem;
 /// \brief A component used to describe animation
 ///
+/// The animation data is shared between components, and states are
+/// referred to by their ID, which avoids looking states up by name
+/// whilst the animation plays.
+///
 /// \note This component assumes that all frames are equal size.
 /// Thus if you would like frames that are not equal sizes,
 /// you must change that.
@@ -45,23 +48,8 @@ struct AnimationSystem;
 /// \author Miguel Martin
 struct AnimationComponent : anax::Component
 {
-    struct State
-    {
-        State() : startPosition{0, 0}, frameAmount{1, 0} {}
-
-        /// The starting position of the animaton
-        sf::Vector2u startPosition;
-
-        /// The amount of frames in each direction
-        sf::Vector2u frameAmount;
-
-        /// The frame rate you wish to play the state at
-        /// Set this to 0 if you wish to use the animation frame rate
-        unsigned int frameRate;
-    };
-
     AnimationComponent() : 
-        currentFrame(0, 0), isPlaying(false), repeat(false)
+        playingState(AnimationData::INVALID_STATE), currentFrame(0), isPlaying(false), repeat(false), m_frameAccumulator(0)
     {
     }
 
@@ -70,17 +58,31 @@ struct AnimationComponent : anax::Component
 #endif // ANAX_VIRTUAL_DTORS_IN_COMPONENT
 
     /// Plays an animation
-    void play(const std::string& state)
+    /// \param state The ID of the state you wish to play
+    void play(AnimationData::StateId state)
     {
+        if(state != playingState)
+        {
+            reset();
+        }
+
         playingState = state;
         isPlaying = true;
     }
 
+    /// Plays an animation
+    /// \param state The name of the state you wish to play
+    /// \note Prefer playing states by their ID, as this looks up the state
+    void play(const std::string& state)
+    {
+        play(data ? data->getStateId(state) : AnimationData::INVALID_STATE);
+    }
+
     /// Resets the animation
     void reset()
     {
-        currentFrame.x = 0;
-        currentFrame.y = 0;
+        currentFrame = 0;
+        m_frameAccumulator = 0;
     }
 
     /// Pauses the animation
@@ -98,23 +100,36 @@ struct AnimationComponent : anax::Component
 
     /// Loads animation data from a stream
     /// \param stream the stream you wish to load data from
-    bool loadData(std::istream& stream);
+    bool loadData(std::istream& stream)
+    {
+        auto loaded = std::make_shared<AnimationData>();
+        if(!loaded->loadData(stream))
+            return false;
+
+        data = loaded;
+        return true;
+    }
 
     /// Loads animation data from a filepath
     /// \param filepath The filepath to the file you wish to load data from
-    bool loadData(const std::string& filepath) { std::ifstream stream{filepath}; return stream.is_open() ? loadData(stream) : false; }
+    bool loadData(const std::string& filepath)
+    {
+        auto loaded = std::make_shared<AnimationData>();
+        if(!loaded->loadData(filepath))
+            return false;
 
-    /// The size of each frame
-    sf::Vector2u frameSize;
+        data = loaded;
+        return true;
+    }
 
-    /// A map to describe the animations the entity has
-    std::map<std::string, State> states;
+    /// The (shared) data of the animation
+    std::shared_ptr<const AnimationData> data;
 
-    /// The current frame number (in both directions)
-    sf::Vector2u currentFrame;
+    /// The currently playing animation state
+    AnimationData::StateId playingState;
 
-    /// The currently playing animation state (represented as a string)
-    std::string playingState;
+    /// The current frame number, within the playing state
+    std::uint32_t currentFrame;
 
     /// Determines if the animation is playing
     bool isPlaying;
@@ -26,9 +26,12 @@
 #ifndef ANAX_EXAMPLES_COMMON_SYSTEMS_COLLISIONSYSTEM_HPP
 #define ANAX_EXAMPLES_COMMON_SYSTEMS_COLLISIONSYSTEM_HPP
 
+#include <utility>
 #include <vector>
 
 #include <anax/System.hpp>
+#include <anax/util/SpatialHashGrid.hpp>
+#include <anax/util/SweepAndPrune.hpp>
 
 #include <Components/TransformComponent.hpp>
 #include <Components/CollisionComponent.hpp>
@@ -44,17 +47,47 @@ struct CollisionSystem : anax::System<anax::Requires<TransformComponent, Collisi
 {
 public:
 
+    /// Describes a pair of entities that have collided
+    using Collision = std::pair<anax::Entity, anax::Entity>;
+
     struct Listener
     {
         virtual ~Listener() = 0;
 
+        /// Occurs once per update, with every collision that has occured
+        /// \param collisions The pairs of entities that have collided
+        /// \note The first entity of each pair is guarenteed to have the causesEvent flag to be true
+        /// \note By default, this calls onCollisionOccured for each collision
+        virtual void onCollisionsOccured(std::vector<Collision>& collisions);
+
         /// Occurs when an Entity has collided with another entity
         /// \param e1 The first entity that has been collided with
         /// \param e2 The second entity that has been collided with
         /// \note e1 Is guarenteed to have the causesEvent flag to be true
-        virtual void onCollisionOccured(anax::Entity& e1, anax::Entity& e2) = 0;
+        virtual void onCollisionOccured(anax::Entity& e1, anax::Entity& e2) {}
     };
 
+    /// The method used to find the colliders that overlap each other
+    enum class Broadphase
+    {
+        /// Colliders are stored within a uniform grid, suited to colliders of a similar size
+        SpatialHash,
+
+        /// Colliders are sorted along an axis, suited to colliders of any size and density
+        SweepAndPrune
+    };
+
+    /// The default size of the cells used to find nearby colliders
+    static constexpr float DEFAULT_CELL_SIZE = 64;
+
+    /// \param cellSize The size of the cells used to find nearby colliders,
+    /// this should be roughly the size of a typical collider
+    explicit CollisionSystem(float cellSize = DEFAULT_CELL_SIZE);
+
+    /// \param broadphase The method used to find the colliders that overlap
+    /// \param cellSize The size of the cells, if a spatial hash is used
+    explicit CollisionSystem(Broadphase broadphase, float cellSize = DEFAULT_CELL_SIZE);
+
     /// Updates the collision system
     /// \param deltaTime The change in time
     void update(double deltaTime);
@@ -67,10 +100,33 @@ public:
     /// \param listener The Listener you wish to remove
     void removeListener(Listener& listener);
 
+    /// \return The method used to find the colliders that overlap
+    Broadphase getBroadphase() const;
+
 private:
 
+    virtual void initialize() override;
+
+    virtual void onEntityAdded(anax::Entity& entity) override;
+
+    virtual void onEntityRemoved(anax::Entity& entity) override;
+
+    virtual void onEntitiesRemapped(const anax::EntityIdRemap& remap) override;
+
     /// The listeners apart of the CollisionSystem
     std::vector<Listener*> m_listeners;
+
+    /// The method used to find the colliders that overlap
+    Broadphase m_broadphase;
+
+    /// Used to find the colliders that are near each other (Broadphase::SpatialHash)
+    anax::util::SpatialHashGrid m_grid;
+
+    /// Used to find the colliders that overlap (Broadphase::SweepAndPrune)
+    anax::util::SweepAndPrune m_sweepAndPrune;
+
+    /// The collisions found in the last update
+    std::vector<Collision> m_collisions;
 };
 
 #endif // ANAX_EXAMPLES_COMMON_SYSTEMS_COLLISIONSYSTEM_HPP
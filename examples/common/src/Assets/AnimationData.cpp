@@ -0,0 +1,453 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <Assets/AnimationData.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <functional>
+#include <sstream>
+
+#include <Assets/MappedFile.hpp>
+
+constexpr AnimationData::StateId AnimationData::INVALID_STATE;
+constexpr std::uint32_t AnimationData::BINARY_VERSION;
+
+/// The first bytes of the binary format
+static const char BINARY_MAGIC[] = { 'A', 'N', 'X', 'A' };
+
+/// Reads little-endian values from binary data, failing (rather than
+/// reading past the end) if the data is truncated
+class BinaryReader
+{
+public:
+
+    BinaryReader(const char* data, std::size_t size) : m_data(data), m_end(data + size) {}
+
+    bool read(std::uint32_t& value)
+    {
+        if(m_end - m_data < 4)
+            return false;
+
+        auto bytes = reinterpret_cast<const unsigned char*>(m_data);
+        value = std::uint32_t(bytes[0]) | std::uint32_t(bytes[1]) << 8 | std::uint32_t(bytes[2]) << 16 | std::uint32_t(bytes[3]) << 24;
+        m_data += 4;
+        return true;
+    }
+
+    bool read(int& value)
+    {
+        std::uint32_t temp;
+        if(!read(temp))
+            return false;
+
+        value = static_cast<std::int32_t>(temp);
+        return true;
+    }
+
+    bool read(std::string& value, std::size_t length)
+    {
+        if(static_cast<std::size_t>(m_end - m_data) < length)
+            return false;
+
+        value.assign(m_data, length);
+        m_data += length;
+        return true;
+    }
+
+    /// \return The amount of bytes left to read
+    std::size_t getRemaining() const { return static_cast<std::size_t>(m_end - m_data); }
+
+private:
+
+    const char* m_data;
+    const char* m_end;
+};
+
+static void write(std::ostream& stream, std::uint32_t value)
+{
+    char bytes[] = { char(value), char(value >> 8), char(value >> 16), char(value >> 24) };
+    stream.write(bytes, sizeof(bytes));
+}
+
+/// Describes a state as it is written within a file, before it is compiled
+struct StateDescription
+{
+    StateDescription() : startPosition{0, 0}, frameAmount{1, 0}, frameRate{0} {}
+
+    /// The starting position of the animaton
+    sf::Vector2u startPosition;
+
+    /// The amount of frames in each direction
+    sf::Vector2u frameAmount;
+
+    /// The frame rate you wish to play the state at
+    unsigned int frameRate;
+};
+
+static void to_lower(std::string& str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+}
+
+static std::string to_lower(const std::string& str)
+{
+    std::string temp(str);
+    to_lower(temp);
+    return temp;
+}
+
+template <typename T>
+static T to_value(const std::string& str)
+{
+    T temp;
+    std::istringstream stream(str);
+    stream >> temp;
+    return temp;
+}
+
+enum class ErrorType
+{
+    None,
+    Syntax
+};
+
+template <typename T>
+static void checkForVariables(std::istream& stream, const std::string& fullVarName, T& obj, const std::unordered_map<std::string, std::function<void (T&, unsigned int value)>> vars, ErrorType* error)
+{
+    std::string buffer; // used temporarily
+
+    // if we don't see a '=' sign,
+    // then there is a syntax error.
+    // if this is the case, we'll just return false
+    if(fullVarName[fullVarName.size() - 1] != '=')
+    {
+        std::cerr << "Syntax error: ";
+        std::cerr << "\"" << fullVarName << "\" is invalid\n";
+        *error = ErrorType::Syntax;
+        return;
+    }
+
+    std::string varName = fullVarName.substr(0, fullVarName.size() - 1);
+
+    // convert the var name to lower case
+    to_lower(varName);
+
+
+    if(stream >> buffer)
+    {
+        to_lower(buffer);
+        unsigned int value = to_value<unsigned int>(buffer);
+
+        // check if variable exsists
+        if(vars.find(varName) == vars.end())
+        {
+            std::cerr << "No such variable as: \"" << varName << "\" variable\n";
+            *error = ErrorType::Syntax;
+            return;
+        }
+        vars.at(varName)(obj, value);
+    }
+}
+
+bool AnimationData::loadData(std::istream& stream)
+{
+    /*
+       The file structure has the following format:
+
+       width= <width>
+       height= <height>
+
+       <state-name>:
+       startx
+       starty<x> <y>
+       framesx <x-count> 
+       framesy <y-count>
+
+       ...
+
+NOTES:
+---
+1. If nothing is supplied for start, then it is assumed it is (0, 0)
+2. If nothing is supplied for frameCount, then it is assumed (1, 0)
+3. This is not case sensitive, but is whitespace (and name) sensitive
+4. You cannot declare global varaible assingments for the animations after
+you declare different states (i.e. do width/height assignment at the TOP of the file).
+*/
+
+    static const std::unordered_map<std::string, std::function<void (AnimationData& anim, unsigned int value)>> animation_variable_assign_map =
+    {
+        {
+            "width",
+            [](AnimationData& anim, unsigned int value)
+            {
+                anim.frameSize.x = value;
+            }
+        },
+        {
+            "height",
+            [](AnimationData& anim, unsigned int value)
+            {
+                anim.frameSize.y = value;
+            }
+        }
+    };
+
+    static const std::unordered_map<std::string, std::function<void (StateDescription& state, unsigned int value)>> state_variable_assign_map =
+    {
+        {
+            "fps",
+            [](StateDescription& state, unsigned int value)
+            {
+                state.frameRate = value;
+            }
+        },
+        {
+            "startx",
+            [](StateDescription& state, unsigned int value)
+            {
+                state.startPosition.x = value;
+            }
+        },
+        {
+            "starty",
+            [](StateDescription& state, unsigned int value)
+            {
+                state.startPosition.y = value;
+            }
+        },
+        {
+            "framesx",
+            [](StateDescription& state, unsigned int value)
+            {
+                state.frameAmount.x = value;
+            }
+        },
+        {
+            "framesy",
+            [](StateDescription& state, unsigned int value)
+            {
+                state.frameAmount.y = value;
+            }
+        }
+    };
+
+    stateNames.clear();
+
+    ErrorType error = ErrorType::None;
+    std::vector<StateDescription> descriptions; // the states, in the order they are declared
+    StateDescription* state = nullptr; // a temporary state variable
+    std::string stateName; // current statename
+    std::string buffer; // temporary buffer
+
+    while(stream >> buffer)
+    {		
+        if(buffer[buffer.size() - 1] == '=')
+        {
+            // for general variables of the animation, e.g. width/height
+            if(state == nullptr)
+            {
+                checkForVariables(stream, buffer, *this, animation_variable_assign_map, &error);
+            }
+            // for the current state
+            else
+            {
+                checkForVariables(stream, buffer, *state, state_variable_assign_map, &error);
+            }
+
+            if(error != ErrorType::None)
+            {
+                return false;
+            }
+        }
+        // if we're requiring a new state name and we didn't see any variables
+        // then we'll search for a state
+        else if(buffer[buffer.size() - 1] == ':')
+        {
+            // otherwise if we did see a statename,
+            // we'll extract the statename
+            stateName = buffer.substr(0, buffer.size() - 1);
+            
+            // create/retrieve the state associated with the name
+            auto id = getStateId(stateName);
+            if(id == INVALID_STATE)
+            {
+                id = static_cast<StateId>(stateNames.size());
+                stateNames.push_back(stateName);
+                descriptions.emplace_back();
+            }
+
+            state = &descriptions[id];
+        }
+    }
+
+    // compile the states, laying out their frames row by row
+    states.clear();
+    frames.clear();
+    for(auto& description : descriptions)
+    {
+        auto columns = std::max(description.frameAmount.x, 1u);
+        auto rows = std::max(description.frameAmount.y, 1u);
+
+        State compiled;
+        compiled.firstFrame = static_cast<std::uint32_t>(frames.size());
+        compiled.frameCount = columns * rows;
+        compiled.frameRate = description.frameRate;
+        states.push_back(compiled);
+
+        for(unsigned int y = 0; y < rows; ++y)
+        {
+            for(unsigned int x = 0; x < columns; ++x)
+            {
+                frames.emplace_back(static_cast<int>(description.startPosition.x + frameSize.x * x),
+                                    static_cast<int>(description.startPosition.y + frameSize.y * y),
+                                    static_cast<int>(frameSize.x),
+                                    static_cast<int>(frameSize.y));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool AnimationData::loadData(const std::string& filepath)
+{
+    MappedFile file;
+    if(!file.open(filepath))
+        return false;
+
+    if(IsBinary(file.getData(), file.getSize()))
+        return loadBinary(file.getData(), file.getSize());
+
+    std::istringstream stream{std::string(file.getData(), file.getSize())};
+    return loadData(stream);
+}
+
+bool AnimationData::loadBinary(const char* data, std::size_t size)
+{
+    if(!IsBinary(data, size))
+    {
+        std::cerr << "Animation data is not of the binary format\n";
+        return false;
+    }
+
+    BinaryReader reader(data + sizeof(BINARY_MAGIC), size - sizeof(BINARY_MAGIC));
+
+    std::uint32_t version;
+    if(!reader.read(version) || version != BINARY_VERSION)
+    {
+        std::cerr << "Unsupported version of animation data\n";
+        return false;
+    }
+
+    std::uint32_t stateCount, frameCount;
+    if(!reader.read(frameSize.x) || !reader.read(frameSize.y) || !reader.read(stateCount) || !reader.read(frameCount))
+    {
+        std::cerr << "Animation data is truncated\n";
+        return false;
+    }
+
+    // the sizes are checked against the data before anything is allocated
+    if(stateCount > reader.getRemaining() / 16 || frameCount > reader.getRemaining() / 16)
+    {
+        std::cerr << "Animation data is truncated\n";
+        return false;
+    }
+
+    states.resize(stateCount);
+    stateNames.resize(stateCount);
+    for(std::uint32_t i = 0; i < stateCount; ++i)
+    {
+        auto& state = states[i];
+
+        std::uint32_t nameLength;
+        if(!reader.read(state.firstFrame) || !reader.read(state.frameCount) || !reader.read(state.frameRate) ||
+           !reader.read(nameLength) || !reader.read(stateNames[i], nameLength))
+        {
+            std::cerr << "Animation data is truncated\n";
+            return false;
+        }
+
+        if(state.frameCount == 0 || state.firstFrame > frameCount || state.frameCount > frameCount - state.firstFrame)
+        {
+            std::cerr << "Animation state \"" << stateNames[i] << "\" has invalid frames\n";
+            return false;
+        }
+    }
+
+    frames.resize(frameCount);
+    for(auto& frame : frames)
+    {
+        if(!reader.read(frame.left) || !reader.read(frame.top) || !reader.read(frame.width) || !reader.read(frame.height))
+        {
+            std::cerr << "Animation data is truncated\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool AnimationData::saveBinary(std::ostream& stream) const
+{
+    stream.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    write(stream, BINARY_VERSION);
+    write(stream, frameSize.x);
+    write(stream, frameSize.y);
+    write(stream, static_cast<std::uint32_t>(states.size()));
+    write(stream, static_cast<std::uint32_t>(frames.size()));
+
+    for(std::size_t i = 0; i < states.size(); ++i)
+    {
+        write(stream, states[i].firstFrame);
+        write(stream, states[i].frameCount);
+        write(stream, states[i].frameRate);
+        write(stream, static_cast<std::uint32_t>(stateNames[i].size()));
+        stream.write(stateNames[i].data(), stateNames[i].size());
+    }
+
+    for(auto& frame : frames)
+    {
+        write(stream, static_cast<std::uint32_t>(frame.left));
+        write(stream, static_cast<std::uint32_t>(frame.top));
+        write(stream, static_cast<std::uint32_t>(frame.width));
+        write(stream, static_cast<std::uint32_t>(frame.height));
+    }
+
+    return static_cast<bool>(stream);
+}
+
+bool AnimationData::IsBinary(const char* data, std::size_t size)
+{
+    return size >= sizeof(BINARY_MAGIC) && std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+AnimationData::StateId AnimationData::getStateId(const std::string& name) const
+{
+    auto it = std::find(stateNames.begin(), stateNames.end(), name);
+    return it != stateNames.end() ? static_cast<StateId>(it - stateNames.begin()) : INVALID_STATE;
+}
@@ -0,0 +1,168 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <Assets/MappedFile.hpp>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace
+{
+    /// The contents of an empty file, which cannot be mapped
+    const char EMPTY_DATA[1] = {};
+}
+
+MappedFile::MappedFile() :
+    m_data(nullptr),
+    m_size(0)
+#ifdef _WIN32
+    , m_mapping(nullptr)
+#endif // _WIN32
+{
+}
+
+MappedFile::MappedFile(const std::string& filepath) :
+    MappedFile()
+{
+    open(filepath);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filepath)
+{
+    close();
+
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    if(size.QuadPart == 0)
+    {
+        // an empty file cannot be mapped, but is opened without data
+        CloseHandle(file);
+        m_data = EMPTY_DATA;
+        return true;
+    }
+
+    // the mapping keeps the file open
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if(!mapping)
+        return false;
+
+    auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(!data)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    m_mapping = mapping;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(m_mapping)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filepath)
+{
+    close();
+
+    int file = ::open(filepath.c_str(), O_RDONLY);
+    if(file == -1)
+        return false;
+
+    struct stat status;
+    if(fstat(file, &status) == -1)
+    {
+        ::close(file);
+        return false;
+    }
+
+    if(status.st_size == 0)
+    {
+        // an empty file cannot be mapped, but is opened without data
+        ::close(file);
+        m_data = EMPTY_DATA;
+        return true;
+    }
+
+    // the mapping keeps the file open
+    auto data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if(data == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<std::size_t>(status.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(m_size > 0)
+        munmap(const_cast<char*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif // _WIN32
@@ -25,57 +25,35 @@
 
 #include <Systems/AnimationSystem.hpp>
 
-#include <iostream>
+#include <cmath>
 
 void AnimationSystem::update(double deltaTime)
 {
-    auto entities = getEntities();
-    for(auto& e : entities)
+    for(auto& e : getEntities())
     {		
         auto& animation = e.getComponent<AnimationComponent>();
-        auto& sprite = e.getComponent<SpriteComponent>().sprite;
-
-        AnimationComponent::State* animationState = nullptr;
-        if(!animation.playingState.empty())
+        if(!animation.data || animation.playingState == AnimationData::INVALID_STATE)
         {
-            animationState = &animation.states[animation.playingState];
+            continue;
         }
 
-        if(animation.isPlaying && animationState)
+        auto& data = *animation.data;
+        auto& animationState = data.states[animation.playingState];
+
+        if(animation.isPlaying)
         {
-            animation.m_frameAccumulator += deltaTime * (animationState->frameRate == 0 ? getFps() : animationState->frameRate);
-            animation.currentFrame.x = (int)animation.m_frameAccumulator;
+            animation.m_frameAccumulator += deltaTime * (animationState.frameRate == 0 ? getFps() : animationState.frameRate);
 
-            if(animation.currentFrame.x >= animationState->frameAmount.x)
+            if(animation.m_frameAccumulator >= animationState.frameCount)
             {
-                // go to the next row (if necessary)
-                if(animationState->frameAmount.y)
-                {
-                    if(animation.currentFrame.y >= animationState->frameAmount.y)
-                    {
-                        animation.currentFrame.y = 0;
-                    }
-                    else
-                    {
-                        ++animation.currentFrame.y;
-                    }
-                }
-
                 // reset the animation
-                animation.currentFrame.x = 0;
-                animation.m_frameAccumulator = 0;
-
+                animation.m_frameAccumulator = animation.repeat ? std::fmod(animation.m_frameAccumulator, animationState.frameCount) : 0;
                 animation.isPlaying = animation.repeat;
             }
-        }
-
-        if(animationState)
-        {
-            sf::IntRect rect(sf::Vector2i(animationState->startPosition.x + animation.frameSize.x * (int)animation.currentFrame.x, 
-                                          animationState->startPosition.y + animation.frameSize.y * (int)animation.currentFrame.y), 
-                             sf::Vector2i(animation.frameSize)); 
 
-            sprite.setTextureRect(rect);
+            animation.currentFrame = static_cast<std::uint32_t>(animation.m_frameAccumulator);
         }
+
+        e.getComponent<SpriteComponent>().sprite.setTextureRect(data.frames[animationState.firstFrame + animation.currentFrame]);
     }
 }
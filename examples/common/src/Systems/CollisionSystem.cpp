@@ -25,59 +25,86 @@
 
 #include <Systems/CollisionSystem.hpp>
 
-#include <iostream>
 #include <algorithm>
+#include <utility>
 
 CollisionSystem::Listener::~Listener()
 {
 }
 
-static sf::FloatRect getBBoxRectFor(const sf::Transformable& transformable, const sf::FloatRect& bbox)
+void CollisionSystem::Listener::onCollisionsOccured(std::vector<Collision>& collisions)
 {
-    return sf::FloatRect(transformable.getPosition().x + bbox.left, transformable.getPosition().y + bbox.top, bbox.width, bbox.height);
+    for(auto& collision : collisions)
+        onCollisionOccured(collision.first, collision.second);
 }
 
-static sf::FloatRect getBBoxRectFor(const anax::Entity& entity)
+constexpr float CollisionSystem::DEFAULT_CELL_SIZE;
+
+static anax::util::Aabb getBoundsFor(const anax::Entity& entity)
 {
-    auto& transform = entity.getComponent<TransformComponent>().transform;
+    auto& position = entity.getComponent<TransformComponent>().transform.getPosition();
     auto& bbox = entity.getComponent<CollisionComponent>().boundingBox;
-    return getBBoxRectFor(transform, bbox);
+
+    anax::util::Aabb bounds;
+    bounds.minX = position.x + bbox.left;
+    bounds.minY = position.y + bbox.top;
+    bounds.maxX = bounds.minX + bbox.width;
+    bounds.maxY = bounds.minY + bbox.height;
+    return bounds;
+}
+
+CollisionSystem::CollisionSystem(float cellSize) :
+    CollisionSystem(Broadphase::SpatialHash, cellSize)
+{
+}
+
+CollisionSystem::CollisionSystem(Broadphase broadphase, float cellSize) :
+    m_broadphase(broadphase),
+    m_grid(cellSize)
+{
 }
 
 void CollisionSystem::update(double)
 {
-    auto colliders = getEntities();
+    // NOTE: This does NOT check for collision with rotation
 
-    // Temporary values for rectangles (to check collision)
-    sf::FloatRect rect1;
-    sf::FloatRect rect2;	
+    m_collisions.clear();
 
-    // NOTES:
-    // 1. This is quite in-efficient, however this is just a simple example.
-    // 2. This does NOT check for collision with rotation
-    for(std::size_t i = 0; i < colliders.size(); ++i)
+    if(m_broadphase == Broadphase::SpatialHash)
     {
-        auto& e1 = colliders[i];
-        if(!e1.getComponent<CollisionComponent>().causesEvents)
-        {
-            continue;
-        }
-
-        rect1 = getBBoxRectFor(e1);
-
-        for(std::size_t j = i+1; j < colliders.size(); ++j)
-        {
-            auto& e2 = colliders[j];
-            rect2 = getBBoxRectFor(e2);
-
-            // Check for the collision
-            if(rect1.intersects(rect2))
-            {
-                for(auto& listener : m_listeners)
-                    listener->onCollisionOccured(e1, e2);
-            }
-        }
+        // colliders only change cells within the grid when necessary
+        for(auto& entity : getEntities())
+            m_grid.update(entity, getBoundsFor(entity));
+
+        m_grid.queryPairs(m_collisions);
     }
+    else
+    {
+        for(auto& entity : getEntities())
+            m_sweepAndPrune.update(entity, getBoundsFor(entity));
+
+        m_sweepAndPrune.queryPairs(m_collisions);
+    }
+
+    // the first entity of each collision must cause events
+    auto end = std::remove_if(m_collisions.begin(), m_collisions.end(), [](Collision& collision)
+    {
+        if(collision.first.getComponent<CollisionComponent>().causesEvents)
+            return false;
+
+        if(!collision.second.getComponent<CollisionComponent>().causesEvents)
+            return true;
+
+        std::swap(collision.first, collision.second);
+        return false;
+    });
+    m_collisions.erase(end, m_collisions.end());
+
+    if(m_collisions.empty())
+        return;
+
+    for(auto& listener : m_listeners)
+        listener->onCollisionsOccured(m_collisions);
 }
 
 void CollisionSystem::addListener(Listener &listener)
@@ -89,3 +116,38 @@ void CollisionSystem::removeListener(Listener &listener)
 {
     m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), &listener), m_listeners.end());
 }
+
+CollisionSystem::Broadphase CollisionSystem::getBroadphase() const
+{
+    return m_broadphase;
+}
+
+void CollisionSystem::initialize()
+{
+    m_grid.clear();
+    m_sweepAndPrune.clear();
+}
+
+void CollisionSystem::onEntityAdded(anax::Entity& entity)
+{
+    if(m_broadphase == Broadphase::SpatialHash)
+        m_grid.insert(entity, getBoundsFor(entity));
+    else
+        m_sweepAndPrune.insert(entity, getBoundsFor(entity));
+}
+
+void CollisionSystem::onEntityRemoved(anax::Entity& entity)
+{
+    if(m_broadphase == Broadphase::SpatialHash)
+        m_grid.remove(entity);
+    else
+        m_sweepAndPrune.remove(entity);
+}
+
+void CollisionSystem::onEntitiesRemapped(const anax::EntityIdRemap& remap)
+{
+    if(m_broadphase == Broadphase::SpatialHash)
+        m_grid.remap(remap);
+    else
+        m_sweepAndPrune.remap(remap);
+}
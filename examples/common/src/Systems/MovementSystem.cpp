@@ -27,14 +27,13 @@
 
 void MovementSystem::update(double deltaTime)
 {
-    auto entities = getEntities();
-    for(auto& entity : entities)
+    for(auto& entity : getEntities())
     {
         auto& transform = entity.getComponent<TransformComponent>().transform;
         auto& velocity = entity.getComponent<VelocityComponent>().velocity;
 
-        velocity *= (float)deltaTime;		
-
-        transform.move(velocity);
+        // NOTE: the velocity must not be scaled in place, as it is
+        // stored in units per second
+        transform.move(velocity * (float)deltaTime);
     }
 }
@@ -0,0 +1,66 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+/// Converts animation data from the text format to the binary format.
+///
+/// Usage: AnimationConverter <input.txt> <output.anim>
+
+#include <fstream>
+#include <iostream>
+
+#include <Assets/AnimationData.hpp>
+
+int main(int argc, char* argv[])
+{
+    if(argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input.txt> <output.anim>\n";
+        return 1;
+    }
+
+    std::ifstream input{argv[1]};
+    if(!input.is_open())
+    {
+        std::cerr << "Failed to open " << argv[1] << '\n';
+        return 1;
+    }
+
+    AnimationData data;
+    if(!data.loadData(input))
+    {
+        std::cerr << "Failed to load animation data from " << argv[1] << '\n';
+        return 1;
+    }
+
+    std::ofstream output{argv[2], std::ios::binary};
+    if(!output.is_open() || !data.saveBinary(output))
+    {
+        std::cerr << "Failed to write " << argv[2] << '\n';
+        return 1;
+    }
+
+    std::cout << "Converted " << data.states.size() << " states (" << data.frames.size() << " frames) to " << argv[2] << '\n';
+    return 0;
+}
@@ -0,0 +1,133 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_CACHEDSYSTEM_HPP
+#define ANAX_CACHEDSYSTEM_HPP
+
+#include <tuple>
+#include <vector>
+
+#include <anax/Entity.hpp>
+#include <anax/FilterOptions.hpp>
+#include <anax/System.hpp>
+
+#include <anax/detail/MemoryUsage.hpp>
+
+namespace anax
+{
+    template <class RequireList, class ExcludeList = Excludes<>>
+    class CachedSystem;
+
+    /// \brief A system which caches a pointer to each required component of its entities
+    /// \tparam Required The components an entity must have
+    /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+    ///
+    /// Iterating over the entities of a system retrieves each component
+    /// through its entity. A CachedSystem instead keeps an array of tuples
+    /// of each entity and pointers to its required components, which is
+    /// rebuilt when first retrieved after the entity version of the system
+    /// changes: after a refresh which changed the entities of the system
+    /// (or activated any of them again), or once a component of one of
+    /// its entities is added, removed or replaced.
+    ///
+    /// \note The components of an entity are not moved once attached, so
+    /// the pointers stay valid until a component of the entity is
+    /// replaced (e.g. adding a component the entity already has) or
+    /// removed, or the entities of the world are compacted
+    ///
+    /// \author Miguel Martin
+    template <class... Required, class ExcludeList>
+    class CachedSystem<Requires<Required...>, ExcludeList> : public System<Requires<Required...>, ExcludeList>
+    {
+    public:
+
+        /// An entity followed by a pointer to each of its required components
+        typedef std::tuple<Entity, Required*...> ComponentTuple;
+
+        /// Default constructor
+        CachedSystem() :
+            m_cachedEntityVersion(0)
+        {
+        }
+
+        /// \return A tuple of each entity within the system and its required
+        /// components, in the same order as the entities of the system
+        /// \note An entity which no longer passes the filter of the system,
+        /// as its components changed since the last refresh, is left out
+        const std::vector<ComponentTuple>& getComponentTuples()
+        {
+            if(m_cachedEntityVersion != this->getEntityVersion())
+            {
+                cacheComponentTuples();
+            }
+
+            return m_componentTuples;
+        }
+
+    protected:
+
+        /// \param filter The filter of the system, which must be
+        /// equivalent to the filter of Requires<Required...> and ExcludeList
+        explicit CachedSystem(const detail::Filter& filter) :
+            System<Requires<Required...>, ExcludeList>{filter},
+            m_cachedEntityVersion(0)
+        {
+        }
+
+    private:
+
+        void cacheComponentTuples()
+        {
+            m_componentTuples.clear();
+            for(auto& handle : this->getEntityHandles())
+            {
+                Entity entity = handle.resolve(this->getWorld());
+
+                // the entity stays within the system until the next refresh
+                if(!this->getFilter().doesPassFilter(entity.getComponentTypeList()))
+                {
+                    continue;
+                }
+
+                m_componentTuples.emplace_back(entity, &entity.getComponent<Required>()...);
+            }
+
+            m_cachedEntityVersion = this->getEntityVersion();
+        }
+
+        virtual detail::MemoryUsage getCacheMemoryUsage() const override
+        {
+            return detail::GetMemoryUsage(m_componentTuples);
+        }
+
+        /// The cached components of the entities within the system
+        std::vector<ComponentTuple> m_componentTuples;
+
+        /// The entity version of the system when the components were cached
+        std::size_t m_cachedEntityVersion;
+    };
+}
+
+#endif // ANAX_CACHEDSYSTEM_HPP
@@ -34,6 +34,12 @@
 
 namespace anax
 {
+    /// \brief An optional base class for components
+    ///
+    /// Components are not required to derive from this class, any
+    /// type that satisfies IsComponent may be used as a component.
+    /// Deriving from Component is only required for a component to
+    /// be retrieved with Entity::getComponents.
     class Component
     {
     public:
@@ -41,12 +47,29 @@ namespace anax
 #	ifdef ANAX_VIRTUAL_DTORS_IN_COMPONENT
         virtual
 #	endif // ANAX_VIRTUAL_DTORS_IN_COMPONENT
-        ~Component() {}
+        ~Component() = default;
     };
 
-    template <class T, class = typename std::enable_if<std::is_base_of<Component, T>::value>::type>
+    /// \brief Determines if a type may be used as a component
+    ///
+    /// Any destructible object type that is not const, volatile or
+    /// an array may be a component; it does not need to derive from
+    /// Component. The lifecycle of a component is managed through the
+    /// type-erased functions within its detail::ComponentTypeInfo.
+    ///
+    /// \tparam T The type to check
+    template <class T>
+    struct IsComponent :
+        std::integral_constant<bool, std::is_object<T>::value &&
+                                     !std::is_const<T>::value &&
+                                     !std::is_volatile<T>::value &&
+                                     !std::is_array<T>::value &&
+                                     std::is_destructible<T>::value> {};
+
+    template <class T, class = typename std::enable_if<IsComponent<T>::value>::type>
     using ComponentPtr = T*;
 
+    /// \note Components that do not derive from Component are null
     using ComponentArray = std::vector<Component*>;
 
     template <class T>
@@ -0,0 +1,166 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_COMPONENTCOLUMNS_HPP
+#define ANAX_COMPONENTCOLUMNS_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <anax/detail/AnaxAssert.hpp>
+
+namespace anax
+{
+    /// The alignment of the columns of components, in bytes,
+    /// which is enough for aligned loads of any vector register
+    constexpr std::size_t COLUMN_ALIGNMENT = 64;
+
+    namespace detail
+    {
+        struct BaseColumns {};
+    }
+
+    /// \brief Describes a component which is stored as a column per member
+    ///
+    /// Components of a StaticWorld are stored as an array of components by
+    /// default. A component whose members are all of the same type may
+    /// instead be stored as a structure of arrays, with an aligned column
+    /// per member, by specialising ComponentColumns:
+    ///
+    /// \code
+    /// namespace anax
+    /// {
+    ///     template <>
+    ///     struct ComponentColumns<Velocity> : Columns<Velocity, float, &Velocity::x, &Velocity::y> {};
+    /// }
+    /// \endcode
+    ///
+    /// Only the members within columns are stored, and the component
+    /// must be default constructible.
+    ///
+    /// \tparam T The type of component
+    /// \tparam Scalar The type of each member stored within a column
+    /// \tparam Members The members of the component, in order of their columns
+    ///
+    /// \author Miguel Martin
+    template <class T, class Scalar, Scalar T::*... Members>
+    struct Columns : detail::BaseColumns
+    {
+        static_assert(std::is_arithmetic<Scalar>::value, "the members of a component stored within columns must be arithmetic");
+        static_assert(sizeof...(Members) > 0, "a component stored within columns must have at least one column");
+
+        /// The type of each member stored within a column
+        typedef Scalar ScalarType;
+
+        /// The amount of columns of the component
+        static constexpr std::size_t COLUMN_COUNT = sizeof...(Members);
+
+        /// \param column The column
+        /// \return The member of the component stored within the column
+        static Scalar T::* GetMember(std::size_t column)
+        {
+            Scalar T::* members[] = { Members... };
+            return members[column];
+        }
+
+        /// \param member The member of the component
+        /// \return The column of the member
+        static std::size_t GetColumn(Scalar T::* member)
+        {
+            for(std::size_t column = 0; column < COLUMN_COUNT; ++column)
+            {
+                if(GetMember(column) == member)
+                {
+                    return column;
+                }
+            }
+
+            ANAX_ASSERT(false, "the member is not stored within a column");
+            return COLUMN_COUNT;
+        }
+    };
+
+    /// \brief Describes how a component is stored within a StaticWorld
+    ///
+    /// Unless specialised to derive from Columns, a component is
+    /// stored within an array of components.
+    ///
+    /// \tparam T The type of component
+    template <class T>
+    struct ComponentColumns {};
+
+    /// \tparam T The type of component
+    /// \return true if the component is stored within columns
+    template <class T>
+    constexpr bool IsStoredInColumns()
+    {
+        return std::is_base_of<detail::BaseColumns, ComponentColumns<T>>::value;
+    }
+
+    /// \brief A contiguous range of the values of a column
+    ///
+    /// \tparam Scalar The type of the values
+    ///
+    /// \author Miguel Martin
+    template <class Scalar>
+    class ColumnSpan
+    {
+    public:
+
+        /// \param data The first value
+        /// \param size The amount of values
+        ColumnSpan(Scalar* data, std::size_t size) :
+            m_data(data),
+            m_size(size)
+        {
+        }
+
+        /// \return The first value, which is aligned to COLUMN_ALIGNMENT
+        Scalar* data() const { return m_data; }
+
+        /// \return The amount of values
+        std::size_t size() const { return m_size; }
+
+        /// \return true if there are no values
+        bool empty() const { return m_size == 0; }
+
+        Scalar* begin() const { return m_data; }
+        Scalar* end() const { return m_data + m_size; }
+
+        /// \param index The index of an entity
+        /// \return The value of the entity
+        Scalar& operator[](std::size_t index) const { return m_data[index]; }
+
+    private:
+
+        /// The first value
+        Scalar* m_data;
+
+        /// The amount of values
+        std::size_t m_size;
+    };
+}
+
+#endif // ANAX_COMPONENTCOLUMNS_HPP
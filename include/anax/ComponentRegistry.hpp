@@ -0,0 +1,256 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_COMPONENTREGISTRY_HPP
+#define ANAX_COMPONENTREGISTRY_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#include <anax/detail/AnaxAssert.hpp>
+#include <anax/detail/ClassTypeId.hpp>
+#include <anax/detail/ComponentTypeList.hpp>
+#include <anax/detail/Filter.hpp>
+#include <anax/detail/StaticComponentList.hpp>
+
+#include <anax/CachedSystem.hpp>
+#include <anax/Component.hpp>
+#include <anax/Config.hpp>
+#include <anax/FilterOptions.hpp>
+#include <anax/System.hpp>
+
+namespace anax
+{
+    /// \brief Assigns the type IDs of components at compile-time
+    ///
+    /// The type ID of a registered component is its position within
+    /// the registry, thus the filters of systems using the registry are
+    /// built at compile-time, instead of retrieving the type ID of each
+    /// component as the system is constructed.
+    ///
+    /// A registry must be registered with Register() before the type
+    /// ID of any component is used, after which the registered
+    /// components may be used with any World. Components that are not
+    /// registered are assigned the type IDs that are not registered.
+    /// Systems of a registry that is not registered build their
+    /// filters at run-time instead.
+    ///
+    /// \see RegisterStableComponentKey to persist components
+    /// by their names
+    ///
+    /// \code
+    /// typedef ComponentRegistry<PositionComponent, VelocityComponent> GameComponents;
+    ///
+    /// struct MovementSystem : GameComponents::System<Requires<PositionComponent, VelocityComponent>>
+    /// {
+    ///     // ...
+    /// };
+    ///
+    /// int main()
+    /// {
+    ///     GameComponents::Register();
+    ///     // ...
+    /// }
+    /// \endcode
+    ///
+    /// \tparam Components The types of components to register
+    ///
+    /// \author Miguel Martin
+    template <class... Components>
+    class ComponentRegistry
+    {
+    private:
+
+        typedef detail::StaticComponentList<Components...> ComponentList;
+
+    public:
+
+        static_assert(sizeof...(Components) <= MAX_AMOUNT_OF_COMPONENTS, "Too many components for ANAX_MAX_AMOUNT_OF_COMPONENTS");
+
+        /// \tparam T The type of component
+        /// \return The type ID of the component
+        template <class T>
+        static constexpr detail::TypeId GetTypeId()
+        {
+            return ComponentList::template GetTypeId<T>();
+        }
+
+        /// \tparam RequireList The components an entity must have, e.g. Requires<A, B>
+        /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+        /// \return The filter of the lists of components
+        template <class RequireList, class ExcludeList = Excludes<>>
+        static constexpr detail::Filter MakeFilter()
+        {
+            return detail::Filter{detail::ComponentTypeList(ComponentList::GetMask(RequireList())),
+                                  detail::ComponentTypeList(ComponentList::GetMask(ExcludeList()))};
+        }
+
+        /// Registers the type ID of every component within the registry
+        /// \return false if the type ID of a component could not be
+        /// registered, e.g. it was used before the registry was registered,
+        /// in which case the registry is not registered
+        /// \note This must be called before the type ID of any component
+        /// is used, e.g. at the start of main()
+        static bool Register()
+        {
+            bool isRegistered = true;
+            using expand = int[];
+            (void)expand{0, (isRegistered &= detail::ClassTypeId<Component>::RegisterTypeId<Components>(GetTypeId<Components>()), 0)...};
+            m_isRegistered = isRegistered;
+            return isRegistered;
+        }
+
+        /// \return true if the registry has been registered
+        static bool IsRegistered()
+        {
+            return m_isRegistered;
+        }
+
+        /// \tparam RequireList The components an entity must have, e.g. Requires<A, B>
+        /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+        /// \return The filter of the lists of components, which is only built
+        /// at compile-time if the registry is registered, as otherwise the
+        /// type IDs of its components may differ from their positions
+        template <class RequireList, class ExcludeList = Excludes<>>
+        static detail::Filter MakeRegisteredFilter()
+        {
+            return IsRegistered() ? MakeFilter<RequireList, ExcludeList>() : detail::MakeFilter<RequireList, ExcludeList>();
+        }
+
+        /// \brief A system whose filter is built at compile-time
+        ///
+        /// \tparam RequireList The components an entity must have, e.g. Requires<A, B>
+        /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+        template <class RequireList, class ExcludeList = Excludes<>>
+        class System : public anax::System<RequireList, ExcludeList>
+        {
+        public:
+
+            /// Default constructor
+            System() :
+                anax::System<RequireList, ExcludeList>{MakeRegisteredFilter<RequireList, ExcludeList>()}
+            {
+            }
+        };
+
+        /// \brief A CachedSystem whose filter is built at compile-time
+        ///
+        /// \tparam RequireList The components an entity must have, e.g. Requires<A, B>
+        /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+        template <class RequireList, class ExcludeList = Excludes<>>
+        class CachedSystem : public anax::CachedSystem<RequireList, ExcludeList>
+        {
+        public:
+
+            /// Default constructor
+            CachedSystem() :
+                anax::CachedSystem<RequireList, ExcludeList>{MakeRegisteredFilter<RequireList, ExcludeList>()}
+            {
+            }
+        };
+
+    private:
+
+        static bool m_isRegistered;
+    };
+
+    template <class... Components>
+    bool ComponentRegistry<Components...>::m_isRegistered = false;
+
+    namespace detail
+    {
+        /// \param name The name you wish to hash
+        /// \param hash The hash of the preceding characters
+        /// \return The 64-bit FNV-1a hash of a name
+        constexpr std::uint64_t HashName(const char* name, std::uint64_t hash = 14695981039346656037ULL)
+        {
+            return *name ? HashName(name + 1, (hash ^ static_cast<unsigned char>(*name)) * 1099511628211ULL) : hash;
+        }
+    }
+
+    /// Describes a component that is not registered with a stable key
+    constexpr std::uint64_t INVALID_STABLE_COMPONENT_KEY = 0;
+
+    /// \param name The stable name of a component, e.g. "game::PositionComponent"
+    /// \return The persistent key of a component, a 64-bit hash of its
+    /// name, which is the same across runs of a program and across modules
+    constexpr std::uint64_t StableComponentKey(const char* name)
+    {
+        return detail::HashName(name);
+    }
+
+    namespace detail
+    {
+        /// Maps the stable key of a component to its type ID
+        /// \param key The stable key of the component
+        /// \param name The stable name of the component
+        /// \param typeId The type ID of the component
+        /// \return false if the key is registered with another name or
+        /// type, or the type is registered with another key
+        bool MapStableComponentKey(std::uint64_t key, const char* name, TypeId typeId);
+    }
+
+    /// Registers a component by a stable name, so that it may be
+    /// persisted (e.g. within saves or over a network) by its stable
+    /// key instead of its type ID.
+    ///
+    /// Registering does not change the type ID of a component: type IDs
+    /// stay dense and depend on the order types are first used, so they
+    /// may differ across runs of a program. Anything stored by type ID,
+    /// such as a component type list, must be remapped through the key
+    /// table, i.e. written as stable keys with GetStableComponentKey and
+    /// read back with GetStableComponentTypeId.
+    /// \tparam T The type of component you wish to register
+    /// \param name The stable name of the component, e.g. "game::PositionComponent"
+    /// \return The stable key of the component, or INVALID_STABLE_COMPONENT_KEY
+    /// if the key of the name is registered to another name or type, or
+    /// the component is registered with another name
+    /// \see GetStableComponentName to retrieve the name a key is registered with
+    template <class T>
+    std::uint64_t RegisterStableComponentKey(const char* name)
+    {
+        static_assert(IsComponent<T>::value, "T is not a component");
+
+        auto key = StableComponentKey(name);
+        return detail::MapStableComponentKey(key, name, ComponentTypeId<T>()) ? key : INVALID_STABLE_COMPONENT_KEY;
+    }
+
+    /// \param key The stable key of a component
+    /// \return The type ID of the component, or INVALID_TYPE_ID if
+    /// no component is registered with the key
+    detail::TypeId GetStableComponentTypeId(std::uint64_t key);
+
+    /// \param typeId The type ID of a component
+    /// \return The stable key of the component, or INVALID_STABLE_COMPONENT_KEY
+    /// if the component is not registered with a stable name
+    std::uint64_t GetStableComponentKey(detail::TypeId typeId);
+
+    /// \param key The stable key of a component
+    /// \return The name the key is registered with, or null if
+    /// no component is registered with the key
+    const char* GetStableComponentName(std::uint64_t key);
+}
+
+#endif // ANAX_COMPONENTREGISTRY_HPP
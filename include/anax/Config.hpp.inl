@@ -30,6 +30,8 @@
 
 #cmakedefine ANAX_32_BIT_ENTITY_IDS @ANAX_32_BIT_ENTITY_IDS@
 #cmakedefine ANAX_VIRTUAL_DTORS_IN_COMPONENT @ANAX_VIRTUAL_DTORS_IN_COMPONENT@
+#cmakedefine ANAX_ENABLE_STATS @ANAX_ENABLE_STATS@
+#cmakedefine ANAX_ENABLE_TRACING @ANAX_ENABLE_TRACING@
 //#cmakedefine ANAX_COMPONENTS_ALIGNED @ANAX_COMPONENTS_ALIGNED@
 
 #ifdef ANAX_32_BIT_ENTITY_IDS
@@ -49,6 +51,12 @@ namespace anax
     /// contain. Try to make this number even, or preferably
     /// a power of 2.
     constexpr const std::size_t MAX_AMOUNT_OF_COMPONENTS = @ANAX_MAX_AMOUNT_OF_COMPONENTS@;
+
+    /// The maximum amount of types of systems, which is the
+    /// amount of types that are ever added to a World (within
+    /// any World). Try to make this number even, or preferably
+    /// a power of 2.
+    constexpr const std::size_t MAX_AMOUNT_OF_SYSTEMS = @ANAX_MAX_AMOUNT_OF_SYSTEMS@;
 }
 
 #endif // ANAX_DETAIL_CONFIG_HPP
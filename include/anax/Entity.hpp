@@ -26,12 +26,16 @@
 #ifndef ANAX_ENTITY_HPP
 #define ANAX_ENTITY_HPP
 
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <cstdint>
 
+#include <anax/detail/AnaxAssert.hpp>
 #include <anax/detail/ClassTypeId.hpp>
 #include <anax/detail/ComponentTypeList.hpp>
+#include <anax/detail/ComponentTypeInfo.hpp>
+#include <anax/detail/ReplaceComponent.hpp>
 
 #include <anax/Component.hpp>
 #include <anax/Config.hpp>
@@ -101,7 +105,7 @@ namespace anax
 
             /// \return The value of the ID, as an integer
             inline int_type value() const
-            { return (counter << ANAX_ENTITY_ID_COUNTER_BIT_COUNT) | index; }
+            { return (static_cast<int_type>(counter) << ANAX_ENTITY_ID_INDEX_BIT_COUNT) | index; }
 
             /// Clears the ID by setting the index and counter to 0.
             void clear() { index = counter = 0; }
@@ -115,12 +119,19 @@ namespace anax
         };
 
         /// Default constructor
-        Entity();
+        Entity() :
+            m_world(nullptr)
+        {
+        }
 
         /// \param world The World the entity belongs to
         /// \param id The designated ID of the Entity
         /// \note You should not call this ctor
-        Entity(World& world, Id id);
+        Entity(World& world, Id id) :
+            m_id(id),
+            m_world(&world)
+        {
+        }
 
         /// Default copy/move ctors and assignment operators
         Entity(const Entity&) = default;
@@ -136,7 +147,7 @@ namespace anax
         bool isValid() const;
 
         /// \return The Entity's ID
-        const Id& getId() const;
+        const Id& getId() const { return m_id; }
 
         /// \return The World that the Entity belongs to.
         /// \note This function will fail if the Entity is null.
@@ -159,9 +170,32 @@ namespace anax
         /// Adds a component to the Entity
         /// \tparam The type of component you wish to add
         /// \param args The arguments for the constructor of the component
+        /// \note If the Entity already has a component of this type, it
+        /// is destroyed and the new component is stored at a different
+        /// address. Use emplaceOrReplace to reuse the existing component.
         template <typename T, typename... Args>
         T& addComponent(Args&&... args);
 
+        /// Replaces a component the Entity already has, within the
+        /// memory of the existing component
+        /// \tparam The type of component you wish to replace
+        /// \param args The arguments for the constructor of the component,
+        /// or a single T which is assigned to the existing component
+        /// \return The component, which keeps its address
+        /// \note A component that cannot be assigned and whose constructor
+        /// may throw is constructed within new memory instead, so that the
+        /// old component is kept if the constructor throws
+        template <typename T, typename... Args>
+        T& replaceComponent(Args&&... args);
+
+        /// Replaces a component if the Entity has one, otherwise adds it
+        /// \tparam The type of component you wish to add or replace
+        /// \param args The arguments for the constructor of the component
+        /// \return The component
+        /// \see replaceComponent
+        template <typename T, typename... Args>
+        T& emplaceOrReplace(Args&&... args);
+
         /// Removes a component
         /// \tparam The type of component you wish to remove
         template <typename T>
@@ -183,6 +217,8 @@ namespace anax
         bool hasComponent() const;
 
         /// \return All the components the Entity has
+        /// \note Components that do not derive from Component are null,
+        /// use getComponentTypeList to determine if they are attached
         ComponentArray getComponents() const;
 
         /// \return A component type list, which resembles the components
@@ -197,11 +233,31 @@ namespace anax
 
         // wrappers to add components
         // so I may call them from templated public interfaces
-        void addComponent(Component* component, detail::TypeId componentTypeId);
+        void* allocateComponent(detail::TypeId componentTypeId, const detail::ComponentTypeInfo& typeInfo);
+        void deallocateComponent(void* memory, detail::TypeId componentTypeId) const;
+        void addComponent(void* component, detail::TypeId componentTypeId);
         void removeComponent(detail::TypeId componentTypeId);
-        Component& getComponent(detail::TypeId componentTypeId) const;
+        void* getComponent(detail::TypeId componentTypeId) const;
         bool hasComponent(detail::TypeId componentTypeId) const;
 
+        template <typename T, typename... Args>
+        T& replaceComponentImpl(std::true_type isReplacedInPlace, Args&&... args);
+        template <typename T, typename... Args>
+        T& replaceComponentImpl(std::false_type isReplacedInPlace, Args&&... args);
+
+        /// \brief Gives memory retrieved from allocateComponent back
+        /// to its pool, to be used with std::unique_ptr
+        struct ComponentDeallocator
+        {
+            const Entity* entity;
+            detail::TypeId componentTypeId;
+
+            void operator()(void* memory) const
+            {
+                entity->deallocateComponent(memory, componentTypeId);
+            }
+        };
+
 
         /// The ID of the Entity
         Id m_id;
@@ -215,31 +271,68 @@ namespace anax
     template <typename T, typename... Args>
     T& Entity::addComponent(Args&&... args)
     {
-        static_assert(std::is_base_of<Component, T>(), "T is not a component, cannot add T to entity");
-        // TODO: align components by type
-        auto component = new T{std::forward<Args>(args)...};
-        addComponent(component, ComponentTypeId<T>());
+        static_assert(IsComponent<T>(), "T is not a component, cannot add T to entity");
+        auto componentTypeId = ComponentTypeId<T>();
+        // the memory is given back to its pool if the constructor throws
+        std::unique_ptr<void, ComponentDeallocator> memory{allocateComponent(componentTypeId, detail::GetComponentTypeInfo<T>()), ComponentDeallocator{this, componentTypeId}};
+        auto component = new (memory.get()) T{std::forward<Args>(args)...};
+        memory.release();
+        addComponent(component, componentTypeId);
+        return *component;
+    }
+
+    template <typename T, typename... Args>
+    T& Entity::replaceComponent(Args&&... args)
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot replace T of entity");
+        return replaceComponentImpl<T>(typename detail::IsReplacedInPlace<T, Args...>::type(), std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+    T& Entity::replaceComponentImpl(std::true_type, Args&&... args)
+    {
+        auto component = static_cast<T*>(getComponent(ComponentTypeId<T>()));
+        detail::ReplaceComponent(*component, std::forward<Args>(args)...);
         return *component;
     }
 
+    template <typename T, typename... Args>
+    T& Entity::replaceComponentImpl(std::false_type, Args&&... args)
+    {
+        // the old component is only destroyed once the new one is constructed
+        ANAX_ASSERT(hasComponent(ComponentTypeId<T>()), "Entity does not contain component");
+        return addComponent<T>(std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+    T& Entity::emplaceOrReplace(Args&&... args)
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot add T to entity");
+        if(hasComponent(ComponentTypeId<T>()))
+        {
+            return replaceComponent<T>(std::forward<Args>(args)...);
+        }
+        return addComponent<T>(std::forward<Args>(args)...);
+    }
+
     template <typename T>
     void Entity::removeComponent()
     {
-        static_assert(std::is_base_of<Component, T>(), "T is not a component, cannot remove T from entity");
+        static_assert(IsComponent<T>(), "T is not a component, cannot remove T from entity");
         removeComponent(ComponentTypeId<T>());
     }
 
     template <typename T>
     T& Entity::getComponent() const
     {
-        static_assert(std::is_base_of<Component, T>(), "T is not a component, cannot retrieve T from entity");
-        return static_cast<T&>(getComponent(ComponentTypeId<T>()));
+        static_assert(IsComponent<T>(), "T is not a component, cannot retrieve T from entity");
+        return *static_cast<T*>(getComponent(ComponentTypeId<T>()));
     }
 
     template <typename T>
     bool Entity::hasComponent() const
     {
-        static_assert(std::is_base_of<Component, T>(), "T is not a component, cannot determine if entity has T");
+        static_assert(IsComponent<T>(), "T is not a component, cannot determine if entity has T");
         return hasComponent(ComponentTypeId<T>());
     }
 }
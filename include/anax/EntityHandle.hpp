@@ -0,0 +1,92 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_ENTITYHANDLE_HPP
+#define ANAX_ENTITYHANDLE_HPP
+
+#include <anax/Entity.hpp>
+
+namespace anax
+{
+    class World;
+
+    /// \brief A compact handle to an Entity, without a reference to its World
+    ///
+    /// An EntityHandle only stores the ID (index and counter) of an
+    /// entity, and is therefore half the size of an Entity (or a
+    /// quarter, with 32-bit IDs). Use it to store references to
+    /// entities within components, or within any other large array,
+    /// and resolve it through the World it belongs to when it must be
+    /// used.
+    ///
+    /// \author Miguel Martin
+    class EntityHandle
+    {
+    public:
+
+        /// Default constructor
+        /// \note The handle is null
+        EntityHandle() = default;
+
+        /// \param id The ID of the entity to refer to
+        explicit EntityHandle(Entity::Id id) :
+            m_id(id)
+        {
+        }
+
+        /// \param entity The entity to refer to
+        EntityHandle(const Entity& entity) :
+            m_id(entity.getId())
+        {
+        }
+
+        /// \return The ID of the entity
+        const Entity::Id& getId() const { return m_id; }
+
+        /// Determines if the handle is null
+        /// \return true if the handle refers to no entity at all
+        bool isNull() const { return m_id.isNull(); }
+
+        /// Resolves the handle into an Entity
+        /// \param world The World the entity belongs to
+        /// \return The Entity the handle refers to
+        /// \see World::isValid To determine if the entity is still alive
+        Entity resolve(World& world) const { return Entity{world, m_id}; }
+
+        /// Comparison operators
+        bool operator==(const EntityHandle& handle) const { return m_id.value() == handle.m_id.value(); }
+        bool operator!=(const EntityHandle& handle) const { return !operator==(handle); }
+        bool operator<(const EntityHandle& handle) const { return m_id.value() < handle.m_id.value(); }
+
+    private:
+
+        /// The ID of the entity
+        Entity::Id m_id;
+    };
+
+    static_assert(sizeof(EntityHandle) == sizeof(Entity::Id::int_type), "EntityHandle must be as small as the ID it stores");
+}
+
+#endif // ANAX_ENTITYHANDLE_HPP
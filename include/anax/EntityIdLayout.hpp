@@ -0,0 +1,85 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_ENTITYIDLAYOUT_HPP
+#define ANAX_ENTITYIDLAYOUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <anax/Config.hpp>
+
+namespace anax
+{
+    /// \brief Describes how the IDs of the entities of a World are laid out
+    ///
+    /// The index and counter of an entity ID are stored within
+    /// ANAX_ENTITY_ID_INDEX_BIT_COUNT and ANAX_ENTITY_ID_COUNTER_BIT_COUNT
+    /// bits; a layout limits how many of these bits a World uses. A World
+    /// with few index bits asserts once it runs out of indices, instead of
+    /// growing its per-entity arrays.
+    ///
+    /// Once the counter of an index reaches its maximum, the index is
+    /// retired rather than wrapping around, so that an old ID can never
+    /// become valid again.
+    ///
+    /// \author Miguel Martin
+    struct EntityIdLayout
+    {
+        /// \param IndexBitCount The amount of bits used for the index of an ID
+        /// \param CounterBitCount The amount of bits used for the counter of an ID
+        constexpr EntityIdLayout(std::size_t IndexBitCount = ANAX_ENTITY_ID_INDEX_BIT_COUNT, std::size_t CounterBitCount = ANAX_ENTITY_ID_COUNTER_BIT_COUNT) :
+            indexBitCount(IndexBitCount),
+            counterBitCount(CounterBitCount)
+        {
+        }
+
+        /// Determines if the layout fits within the bits of an ID
+        /// \return true if the layout can be used by a World
+        constexpr bool isValid() const
+        {
+            return indexBitCount > 0 && indexBitCount <= ANAX_ENTITY_ID_INDEX_BIT_COUNT &&
+                   counterBitCount > 0 && counterBitCount <= ANAX_ENTITY_ID_COUNTER_BIT_COUNT;
+        }
+
+        /// \return The amount of indices that may be given out
+        constexpr std::uint64_t getMaxIndexCount() const
+        {
+            return std::uint64_t(1) << indexBitCount;
+        }
+
+        /// \return The maximum value of a counter, an index is
+        /// retired once its counter reaches this value
+        constexpr std::uint64_t getMaxCounter() const
+        {
+            return (std::uint64_t(1) << counterBitCount) - 1;
+        }
+
+        std::size_t indexBitCount;
+        std::size_t counterBitCount;
+    };
+}
+
+#endif // ANAX_ENTITYIDLAYOUT_HPP
@@ -0,0 +1,74 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_ENTITYIDRECYCLING_HPP
+#define ANAX_ENTITYIDRECYCLING_HPP
+
+#include <cstddef>
+
+namespace anax
+{
+    /// \brief Describes the order in which the indices of killed entities are re-used
+    enum class EntityIdRecyclingOrder
+    {
+        /// The most recently freed index is re-used first
+        LIFO,
+
+        /// The least recently freed index is re-used first
+        FIFO,
+
+        /// The lowest free index is re-used first, which keeps
+        /// the entities within a dense range of indices
+        LOWEST_INDEX_FIRST
+    };
+
+    /// \brief Describes how a World re-uses the indices of killed entities
+    ///
+    /// Re-using an index right after it is freed churns the counter
+    /// of that index, and puts the components of the new entity
+    /// where the components of the killed entity were. A quarantine
+    /// holds the quarantineCount most recently freed indices aside,
+    /// whatever the order: an index may only be re-used once at least
+    /// quarantineCount indices have been freed after it, and the
+    /// indices released from the quarantine are then re-used in the
+    /// order of the policy.
+    ///
+    /// \author Miguel Martin
+    struct EntityIdRecycling
+    {
+        /// \param Order The order in which free indices are re-used
+        /// \param QuarantineCount The amount of most recently freed indices to hold aside
+        constexpr EntityIdRecycling(EntityIdRecyclingOrder Order = EntityIdRecyclingOrder::LIFO, std::size_t QuarantineCount = 0) :
+            order(Order),
+            quarantineCount(QuarantineCount)
+        {
+        }
+
+        EntityIdRecyclingOrder order;
+        std::size_t quarantineCount;
+    };
+}
+
+#endif // ANAX_ENTITYIDRECYCLING_HPP
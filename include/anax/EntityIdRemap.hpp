@@ -0,0 +1,95 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_ENTITYIDREMAP_HPP
+#define ANAX_ENTITYIDREMAP_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <anax/Entity.hpp>
+#include <anax/EntityHandle.hpp>
+
+namespace anax
+{
+    /// \brief Maps the old IDs of entities moved by World::compact to their new IDs
+    ///
+    /// The old IDs of moved entities are invalidated by compacting a
+    /// World; use this table to update the entities and handles you
+    /// hold. IDs of entities that were not moved, and IDs that were
+    /// already invalid, are left unchanged.
+    ///
+    /// \author Miguel Martin
+    class EntityIdRemap
+    {
+    public:
+
+        /// \brief Describes an entity moved to another index
+        struct Move
+        {
+            /// The ID of the entity before it was moved
+            Entity::Id from;
+
+            /// The ID of the entity after it was moved
+            Entity::Id to;
+        };
+
+        /// Default constructor
+        /// \note No entities are moved
+        EntityIdRemap() = default;
+
+        /// \param moves The entities that were moved
+        explicit EntityIdRemap(std::vector<Move> moves);
+
+        /// \param id The ID of an entity
+        /// \return The new ID of the entity, or id if it was not moved
+        Entity::Id remap(Entity::Id id) const;
+
+        /// \param handle A handle to an entity
+        /// \return A handle to the entity after it was moved
+        EntityHandle remap(const EntityHandle& handle) const { return EntityHandle{remap(handle.getId())}; }
+
+        /// \param entity An entity
+        /// \return The entity after it was moved
+        Entity remap(const Entity& entity) const;
+
+        /// \return The entities that were moved
+        const std::vector<Move>& getMoves() const { return m_moves; }
+
+        /// \return true if no entities were moved
+        bool empty() const { return m_moves.empty(); }
+
+    private:
+
+        /// The entities that were moved
+        std::vector<Move> m_moves;
+
+        /// The position of the move of an entity within m_moves,
+        /// the index of this array is the index the entity was moved from
+        std::vector<std::size_t> m_positions;
+    };
+}
+
+#endif // ANAX_ENTITYIDREMAP_HPP
@@ -0,0 +1,126 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_ENTITYRANGE_HPP
+#define ANAX_ENTITYRANGE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <anax/EntityHandle.hpp>
+
+namespace anax
+{
+    /// \brief A view of an array of entity handles, as entities
+    ///
+    /// Systems and worlds store their entities as compact
+    /// EntityHandle objects; this range resolves each handle to an
+    /// Entity of the World the handles belong to whilst iterating.
+    ///
+    /// \note The range is invalidated by World::refresh, as it
+    /// refers to the storage of the World or System it came from.
+    ///
+    /// \author Miguel Martin
+    class EntityRange
+    {
+    public:
+
+        class Iterator
+        {
+        public:
+
+            typedef std::input_iterator_tag iterator_category;
+            typedef Entity value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef Entity* pointer;
+            typedef Entity& reference;
+
+            Iterator(World* world, const EntityHandle* handle) :
+                m_world(world),
+                m_handle(handle)
+            {
+            }
+
+            /// \note The returned reference is only valid until
+            /// the iterator is incremented
+            Entity& operator*() const
+            {
+                m_entity = m_handle->resolve(*m_world);
+                return m_entity;
+            }
+
+            Entity* operator->() const { return &operator*(); }
+
+            Iterator& operator++() { ++m_handle; return *this; }
+            Iterator operator++(int) { Iterator temp{*this}; ++m_handle; return temp; }
+
+            bool operator==(const Iterator& it) const { return m_handle == it.m_handle; }
+            bool operator!=(const Iterator& it) const { return m_handle != it.m_handle; }
+
+        private:
+
+            World* m_world;
+            const EntityHandle* m_handle;
+
+            /// The entity the current handle resolves to
+            mutable Entity m_entity;
+        };
+
+        /// \param world The World the handles belong to, this may only
+        /// be null if there are no handles
+        /// \param handles The handles to view
+        EntityRange(World* world, const std::vector<EntityHandle>& handles) :
+            m_world(world),
+            m_handles(handles.data()),
+            m_size(handles.size())
+        {
+        }
+
+        Iterator begin() const { return Iterator{m_world, m_handles}; }
+        Iterator end() const { return Iterator{m_world, m_handles + m_size}; }
+
+        /// \return The amount of entities within the range
+        std::size_t size() const { return m_size; }
+
+        /// \return true if there are no entities within the range
+        bool empty() const { return m_size == 0; }
+
+        /// \param index The index of the entity within the range
+        /// \return The entity at index
+        Entity operator[](std::size_t index) const { return m_handles[index].resolve(*m_world); }
+
+        /// \return A copy of the range, as an array of entities
+        operator std::vector<Entity>() const { return std::vector<Entity>(begin(), end()); }
+
+    private:
+
+        World* m_world;
+        const EntityHandle* m_handles;
+        std::size_t m_size;
+    };
+}
+
+#endif // ANAX_ENTITYRANGE_HPP
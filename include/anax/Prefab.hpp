@@ -0,0 +1,170 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_PREFAB_HPP
+#define ANAX_PREFAB_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <anax/detail/AlignedMemory.hpp>
+#include <anax/detail/ClassTypeId.hpp>
+#include <anax/detail/ComponentTypeList.hpp>
+#include <anax/detail/ComponentTypeInfo.hpp>
+
+#include <anax/Component.hpp>
+
+namespace anax
+{
+    /// \brief A set of components that may be instantiated many times
+    ///
+    /// A prefab captures a set of components once, which may then
+    /// be copied to many entities at once with World::instantiate.
+    /// This is considerably cheaper than applying an entity template
+    /// to each entity separately.
+    ///
+    /// \see World::instantiate
+    ///
+    /// \author Miguel Martin
+    class Prefab
+    {
+    public:
+
+        /// Default constructor
+        Prefab() = default;
+
+        Prefab(const Prefab&) = delete;
+        Prefab(Prefab&&) = default;
+        Prefab& operator=(const Prefab&) = delete;
+        Prefab& operator=(Prefab&&) = default;
+
+        /// Adds a component to the Prefab
+        /// \tparam The type of component you wish to add
+        /// \param args The arguments for the constructor of the component
+        /// \note If the prefab already contains a component of this
+        /// type, it will be replaced
+        template <typename T, typename... Args>
+        T& addComponent(Args&&... args);
+
+        /// Removes a component from the Prefab
+        /// \tparam The type of component you wish to remove
+        template <typename T>
+        void removeComponent();
+
+        /// Retrieves a component from this Prefab
+        /// \tparam The type of component you wish to retrieve
+        /// \return The component
+        template <typename T>
+        T& getComponent() const;
+
+        /// Determines if this Prefab has a component or not
+        /// \tparam The type of component you wish to check for
+        /// \return true if this Prefab contains a component
+        template <typename T>
+        bool hasComponent() const;
+
+        /// \return A component type list, which resembles the components
+        /// this prefab contains
+        const detail::ComponentTypeList& getComponentTypeList() const;
+
+    private:
+
+        typedef std::unique_ptr<void, void (*)(void*)> PrototypePtr;
+
+        /// \brief A component that is copied to every instance of the prefab
+        struct Prototype
+        {
+            /// The type of the component
+            detail::TypeId typeId;
+
+            /// The type information for the component
+            const detail::ComponentTypeInfo* typeInfo;
+
+            /// The component itself
+            PrototypePtr component;
+        };
+
+        template <typename T>
+        static void DeleteComponent(void* component)
+        {
+            static_cast<T*>(component)->~T();
+            detail::FreeAligned(component);
+        }
+
+        // wrappers so I may call them from templated public interfaces
+        void addComponent(PrototypePtr component, detail::TypeId componentTypeId, const detail::ComponentTypeInfo& typeInfo);
+        void removeComponent(detail::TypeId componentTypeId);
+        void* getComponent(detail::TypeId componentTypeId) const;
+        bool hasComponent(detail::TypeId componentTypeId) const;
+
+        /// The components of the prefab
+        std::vector<Prototype> m_prototypes;
+
+        /// A list of component types, which resembles
+        /// what components the prefab has
+        detail::ComponentTypeList m_componentTypeList;
+
+        friend class World;
+    };
+
+    template <typename T, typename... Args>
+    T& Prefab::addComponent(Args&&... args)
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot add T to prefab");
+        static_assert(std::is_copy_constructible<T>(), "T is not copyable, cannot add T to prefab");
+        // the memory is aligned for the component, which may be over-aligned
+        std::unique_ptr<void, detail::AlignedDeleter> memory{detail::AllocateAligned(sizeof(T), alignof(T))};
+        auto component = new (memory.get()) T{std::forward<Args>(args)...};
+        memory.release();
+
+        addComponent(PrototypePtr{component, &DeleteComponent<T>}, ComponentTypeId<T>(), detail::GetComponentTypeInfo<T>());
+        return *component;
+    }
+
+    template <typename T>
+    void Prefab::removeComponent()
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot remove T from prefab");
+        removeComponent(ComponentTypeId<T>());
+    }
+
+    template <typename T>
+    T& Prefab::getComponent() const
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot retrieve T from prefab");
+        return *static_cast<T*>(getComponent(ComponentTypeId<T>()));
+    }
+
+    template <typename T>
+    bool Prefab::hasComponent() const
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot determine if prefab has T");
+        return hasComponent(ComponentTypeId<T>());
+    }
+}
+
+#endif // ANAX_PREFAB_HPP
@@ -0,0 +1,448 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_STATICWORLD_HPP
+#define ANAX_STATICWORLD_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <anax/detail/AnaxAssert.hpp>
+#include <anax/detail/EntityIdPool.hpp>
+#include <anax/detail/StaticColumnPool.hpp>
+#include <anax/detail/StaticComponentList.hpp>
+#include <anax/detail/StaticComponentPool.hpp>
+
+#include <anax/Component.hpp>
+#include <anax/ComponentColumns.hpp>
+#include <anax/Config.hpp>
+#include <anax/Entity.hpp>
+#include <anax/EntityIdLayout.hpp>
+#include <anax/EntityIdRecycling.hpp>
+#include <anax/FilterOptions.hpp>
+
+namespace anax
+{
+    /// \brief A World where the types of components are known at compile-time
+    ///
+    /// The type ID of a component is its position within the component
+    /// list of the world, and each type of component is stored within
+    /// its own typed pool, indexed by the index of an entity. Thus type
+    /// IDs and filters are constant expressions, and accessing a
+    /// component is a single array access which may be inlined.
+    ///
+    /// Entities are referred to by their IDs. Unlike a World, there is
+    /// no activation nor refresh: entities and components are added and
+    /// removed immediately, and systems are functions given to forEach.
+    ///
+    /// \code
+    /// StaticWorld<Position, Velocity> world;
+    /// world.forEach<Requires<Position, Velocity>>([](StaticWorld<Position, Velocity>::Id id, Position& position, Velocity& velocity)
+    /// {
+    ///     position.x += velocity.x;
+    /// });
+    /// \endcode
+    ///
+    /// \tparam Components The types of components the world may contain
+    ///
+    /// Components which specialise ComponentColumns are stored as an
+    /// aligned column per member instead, which may be retrieved with
+    /// getColumn() and iterated over with forEachRange(). As they are
+    /// not stored as objects, they are retrieved by value.
+    ///
+    /// \note Creating entities may move the components of the world,
+    /// which invalidates references to components and columns.
+    ///
+    /// \author Miguel Martin
+    template <class... Components>
+    class StaticWorld
+    {
+    private:
+
+        typedef detail::StaticComponentList<Components...> ComponentList;
+
+        /// The pool of a type of component
+        template <class T>
+        using Pool = typename std::conditional<IsStoredInColumns<T>(), detail::StaticColumnPool<T>, detail::StaticComponentPool<T>>::type;
+
+    public:
+
+        /// Describes the ID of an entity within the world
+        typedef Entity::Id Id;
+
+        /// Describes the set of components an entity has
+        typedef typename ComponentList::Mask Mask;
+
+        /// \tparam T The type of component
+        /// \return The type ID of the component within this world
+        template <class T>
+        static constexpr detail::TypeId ComponentTypeId()
+        {
+            return ComponentList::template GetTypeId<T>();
+        }
+
+        /// \tparam RequireList The components an entity must have, e.g. Requires<A, B>
+        /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+        /// \param mask The mask of the components of an entity
+        /// \return true if an entity with the mask passes the filter
+        template <class RequireList, class ExcludeList = Excludes<>>
+        static constexpr bool DoesPassFilter(Mask mask)
+        {
+            return (mask & (ComponentList::GetMask(RequireList()) | AliveMask())) == (ComponentList::GetMask(RequireList()) | AliveMask()) &&
+                   (mask & ComponentList::GetMask(ExcludeList())) == 0;
+        }
+
+        /// \param entityPoolSize The amount of entities to reserve memory for
+        /// \param idLayout The layout of the IDs of the entities
+        /// \param idRecycling How the indices of killed entities are re-used
+        explicit StaticWorld(std::size_t entityPoolSize = DEFAULT_ENTITY_POOL_SIZE, const EntityIdLayout& idLayout = EntityIdLayout{}, const EntityIdRecycling& idRecycling = EntityIdRecycling{}) :
+            m_entityIdPool(entityPoolSize, idLayout, idRecycling),
+            m_entityCount(0),
+            m_indexCount(0)
+        {
+            static_assert(AllComponents<Components...>::value, "Every type of a StaticWorld must be a component");
+            resize(entityPoolSize);
+        }
+
+        ~StaticWorld()
+        {
+            destroyAllComponents();
+        }
+
+        StaticWorld(const StaticWorld&) = delete;
+        StaticWorld(StaticWorld&&) = delete;
+        StaticWorld& operator=(const StaticWorld&) = delete;
+        StaticWorld& operator=(StaticWorld&&) = delete;
+
+        /// Creates an entity
+        /// \return The ID of the entity
+        Id createEntity()
+        {
+            auto size = m_entityIdPool.getSize();
+            if(m_entityIdPool.getRequiredSize(1) > size)
+            {
+                auto maxIndexCount = m_entityIdPool.getLayout().getMaxIndexCount();
+                resize(static_cast<std::size_t>(std::min<std::uint64_t>(std::max<std::size_t>(1, size * 2), maxIndexCount)));
+            }
+
+            auto id = m_entityIdPool.create();
+            m_masks[id.index] = AliveMask();
+            m_indexCount = std::max<std::size_t>(m_indexCount, id.index + 1);
+            ++m_entityCount;
+            return id;
+        }
+
+        /// Kills an entity, destroying its components immediately
+        /// \param id The entity you wish to kill
+        void killEntity(Id id)
+        {
+            ANAX_ASSERT(isValid(id), "invalid entity tried to be killed");
+
+            destroyComponents(id.index);
+            m_masks[id.index] = 0;
+            m_entityIdPool.remove(id);
+            --m_entityCount;
+        }
+
+        /// \param id The ID of the entity
+        /// \return true if the entity is alive within the world
+        bool isValid(Id id) const
+        {
+            return m_entityIdPool.isValid(id);
+        }
+
+        /// Adds a component to an entity
+        /// \tparam T The type of component you wish to add
+        /// \param id The entity you wish to add the component to
+        /// \param args The arguments for the constructor of the component
+        /// \return The component, or a copy of it if it is stored within columns
+        /// \note An existing component of the same type is replaced
+        template <class T, class... Args>
+        typename Pool<T>::Reference addComponent(Id id, Args&&... args)
+        {
+            ANAX_ASSERT(isValid(id), "invalid entity cannot have components added to it");
+
+            if(hasComponent<T>(id))
+            {
+                getPool<T>().destroy(id.index);
+            }
+
+            typename Pool<T>::Reference component = getPool<T>().construct(id.index, std::forward<Args>(args)...);
+            m_masks[id.index] |= ComponentMask<T>();
+            return component;
+        }
+
+        /// Removes a component from an entity
+        /// \tparam T The type of component you wish to remove
+        /// \param id The entity you wish to remove the component from
+        template <class T>
+        void removeComponent(Id id)
+        {
+            ANAX_ASSERT(hasComponent<T>(id), "entity does not have the component to remove");
+
+            getPool<T>().destroy(id.index);
+            m_masks[id.index] &= ~ComponentMask<T>();
+        }
+
+        /// \tparam T The type of component you wish to retrieve
+        /// \param id The entity you wish to retrieve the component of
+        /// \return The component of the entity, or a copy of it if it is stored within columns
+        template <class T>
+        typename Pool<T>::Reference getComponent(Id id)
+        {
+            ANAX_ASSERT(hasComponent<T>(id), "entity does not have the component");
+            return getPool<T>().get(id.index);
+        }
+
+        /// \tparam T The type of component you wish to retrieve
+        /// \param id The entity you wish to retrieve the component of
+        /// \return The component of the entity, or a copy of it if it is stored within columns
+        template <class T>
+        typename Pool<T>::ConstReference getComponent(Id id) const
+        {
+            ANAX_ASSERT(hasComponent<T>(id), "entity does not have the component");
+            return getPool<T>().get(id.index);
+        }
+
+        /// \tparam T The type of component you wish to check for
+        /// \param id The entity you wish to check
+        /// \return true if the entity has the component
+        template <class T>
+        bool hasComponent(Id id) const
+        {
+            return isValid(id) && (m_masks[id.index] & ComponentMask<T>()) != 0;
+        }
+
+        /// \param id The ID of the entity
+        /// \return The mask of the components of the entity
+        Mask getComponentMask(Id id) const
+        {
+            ANAX_ASSERT(isValid(id), "invalid entity does not have components");
+            return m_masks[id.index];
+        }
+
+        /// Calls a function for every entity which passes a filter, in
+        /// order of the index of the entities
+        /// \tparam RequireList The components an entity must have, e.g. Requires<A, B>
+        /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+        /// \param function The function to call, with the ID of the entity
+        /// and a reference to each required component
+        /// \note Entities may be killed and components removed within the function
+        template <class RequireList, class ExcludeList = Excludes<>, class Function>
+        void forEach(Function function)
+        {
+            static_assert(std::is_base_of<detail::BaseRequires, RequireList>::value, "RequireList is not a requirement list");
+            static_assert(std::is_base_of<detail::BaseExcludes, ExcludeList>::value, "ExcludeList is not an excludes list");
+            forEachImpl<RequireList, ExcludeList>(RequireList(), function);
+        }
+
+        /// Calls a function for every range of consecutive indices of
+        /// entities which pass a filter, in order of the index of the
+        /// entities. The columns of components may then be processed
+        /// a range at a time.
+        /// \tparam RequireList The components an entity must have, e.g. Requires<A, B>
+        /// \tparam ExcludeList The components an entity must not have, e.g. Excludes<C>
+        /// \param function The function to call, with the first index
+        /// and one past the last index of the range
+        /// \note Entities must not be created within the function
+        template <class RequireList, class ExcludeList = Excludes<>, class Function>
+        void forEachRange(Function function)
+        {
+            static_assert(std::is_base_of<detail::BaseRequires, RequireList>::value, "RequireList is not a requirement list");
+            static_assert(std::is_base_of<detail::BaseExcludes, ExcludeList>::value, "ExcludeList is not an excludes list");
+
+            std::size_t i = 0;
+            while(i < m_indexCount)
+            {
+                if(!DoesPassFilter<RequireList, ExcludeList>(m_masks[i]))
+                {
+                    ++i;
+                    continue;
+                }
+
+                auto begin = i;
+                while(i < m_indexCount && DoesPassFilter<RequireList, ExcludeList>(m_masks[i]))
+                {
+                    ++i;
+                }
+                function(begin, i);
+            }
+        }
+
+        /// \param member The member of a component stored within columns
+        /// \return The column of the member, indexed by the index of an entity
+        /// \note The values at the indices of entities without the component are unspecified
+        template <class T, class Scalar>
+        ColumnSpan<Scalar> getColumn(Scalar T::* member)
+        {
+            static_assert(IsStoredInColumns<T>(), "the component is not stored within columns");
+            return ColumnSpan<Scalar>{getPool<T>().getColumn(ComponentColumns<T>::GetColumn(member)), m_indexCount};
+        }
+
+        /// \param member The member of a component stored within columns
+        /// \return The column of the member, indexed by the index of an entity
+        /// \note The values at the indices of entities without the component are unspecified
+        template <class T, class Scalar>
+        ColumnSpan<const Scalar> getColumn(Scalar T::* member) const
+        {
+            static_assert(IsStoredInColumns<T>(), "the component is not stored within columns");
+            return ColumnSpan<const Scalar>{getPool<T>().getColumn(ComponentColumns<T>::GetColumn(member)), m_indexCount};
+        }
+
+        /// \return The amount of entities that are alive
+        std::size_t getEntityCount() const
+        {
+            return m_entityCount;
+        }
+
+        /// Kills every entity within the world
+        void clear()
+        {
+            destroyAllComponents();
+
+            auto capacity = m_entityIdPool.getSize();
+            m_entityIdPool.clear();
+            m_entityIdPool.resize(capacity);
+            std::fill(m_masks.begin(), m_masks.end(), Mask(0));
+            m_entityCount = 0;
+            m_indexCount = 0;
+        }
+
+    private:
+
+        template <class... Types>
+        struct AllComponents : std::true_type {};
+
+        template <class T, class... Types>
+        struct AllComponents<T, Types...> :
+            std::integral_constant<bool, IsComponent<T>::value && AllComponents<Types...>::value> {};
+
+        /// A bit, after the bits of the components, which is set while an entity is alive
+        static constexpr Mask AliveMask()
+        {
+            return Mask(1) << sizeof...(Components);
+        }
+
+        template <class T>
+        static constexpr Mask ComponentMask()
+        {
+            return Mask(1) << ComponentTypeId<T>();
+        }
+
+        template <class T>
+        Pool<T>& getPool()
+        {
+            return std::get<ComponentTypeId<T>()>(m_pools);
+        }
+
+        template <class T>
+        const Pool<T>& getPool() const
+        {
+            return std::get<ComponentTypeId<T>()>(m_pools);
+        }
+
+        template <class RequireList, class ExcludeList, class Function, class... Required>
+        void forEachImpl(detail::TypeList<Required...>, Function& function)
+        {
+            for(std::size_t i = 0; i < m_indexCount; ++i)
+            {
+                if(DoesPassFilter<RequireList, ExcludeList>(m_masks[i]))
+                {
+                    function(m_entityIdPool.get(i), getPool<Required>().get(i)...);
+                }
+            }
+        }
+
+        template <class T>
+        int destroyComponent(std::size_t index)
+        {
+            if(m_masks[index] & ComponentMask<T>())
+            {
+                getPool<T>().destroy(index);
+            }
+            return 0;
+        }
+
+        /// Destroys every component of an entity
+        void destroyComponents(std::size_t index)
+        {
+            using expand = int[];
+            (void)expand{0, destroyComponent<Components>(index)...};
+        }
+
+        void destroyAllComponents()
+        {
+            for(std::size_t i = 0; i < m_indexCount; ++i)
+            {
+                destroyComponents(i);
+            }
+        }
+
+        template <class T>
+        int resizePool(std::size_t capacity)
+        {
+            getPool<T>().resize(capacity, [this](std::size_t index)
+            {
+                return (m_masks[index] & ComponentMask<T>()) != 0;
+            });
+            return 0;
+        }
+
+        /// Resizes the storage of the world
+        /// \param capacity The amount of entities to store
+        void resize(std::size_t capacity)
+        {
+            using expand = int[];
+            (void)expand{0, resizePool<Components>(capacity)...};
+
+            m_entityIdPool.resize(capacity);
+            m_masks.resize(capacity, Mask(0));
+        }
+
+        /// A pool storage of the IDs for the entities within the world
+        detail::EntityIdPool m_entityIdPool;
+
+        /// The pools of components, the index of this tuple
+        /// is the type ID of the component
+        std::tuple<Pool<Components>...> m_pools;
+
+        /// The components of each entity, the index of this
+        /// array is the index of the entity
+        std::vector<Mask> m_masks;
+
+        /// The amount of entities that are alive
+        std::size_t m_entityCount;
+
+        /// One past the greatest index of an entity given out
+        std::size_t m_indexCount;
+    };
+}
+
+#endif // ANAX_STATICWORLD_HPP
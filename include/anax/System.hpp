@@ -32,6 +32,15 @@ namespace anax
             BaseSystem{detail::MakeFilter<RequireList, ExcludeList>()}
         {
         }
+
+    protected:
+
+        /// \param filter The filter of the system, which must be
+        /// equivalent to the filter of RequireList and ExcludeList
+        explicit System(const detail::Filter& filter) :
+            BaseSystem{filter}
+        {
+        }
     };
 
     template<class T>
@@ -26,18 +26,32 @@
 #ifndef ANAX_WORLD_HPP
 #define ANAX_WORLD_HPP
 
+#include <bitset>
 #include <vector>
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 #include <anax/detail/EntityIdPool.hpp>
 #include <anax/detail/EntityComponentStorage.hpp>
+#include <anax/detail/EntityHierarchy.hpp>
 
+#include <anax/CachedSystem.hpp>
 #include <anax/Component.hpp>
 #include <anax/Entity.hpp>
+#include <anax/EntityHandle.hpp>
+#include <anax/EntityIdLayout.hpp>
+#include <anax/EntityIdRecycling.hpp>
+#include <anax/EntityIdRemap.hpp>
+#include <anax/EntityRange.hpp>
+#include <anax/Prefab.hpp>
 #include <anax/System.hpp>
+#include <anax/WorldMemoryReport.hpp>
+#include <anax/WorldStats.hpp>
+#include <anax/util/TraceRecorder.hpp>
 
 namespace anax
 {
@@ -61,6 +75,15 @@ namespace anax
         /// Describes an array of Entities
         using EntityArray = std::vector<Entity>;
 
+        /// Describes an array of compact entity handles
+        using EntityHandleArray = std::vector<EntityHandle>;
+
+        /// Describes an entity within the hierarchy
+        using HierarchyNode = detail::EntityHierarchy::Node;
+
+        /// Describes the hierarchy of entities, ordered by depth
+        using HierarchyArray = std::vector<HierarchyNode>;
+
         /// Default Constructor
         World();
 
@@ -68,6 +91,12 @@ namespace anax
         /// \param entityPoolSize The amount of entities you wish to have pooled ready to use by default
         explicit World(std::size_t entityPoolSize);
 
+        /// Constructs the world with a custom layout of entity IDs
+        /// \param entityPoolSize The amount of entities you wish to have pooled ready to use by default
+        /// \param idLayout The layout of the IDs of the entities within the world
+        /// \param idRecycling How the indices of killed entities are re-used
+        World(std::size_t entityPoolSize, const EntityIdLayout& idLayout, const EntityIdRecycling& idRecycling = EntityIdRecycling{});
+
         World(const World& world) = delete;
         World(World&& world) = delete;
         World& operator=(const World&) = delete;
@@ -102,6 +131,16 @@ namespace anax
         /// Removes all the systems from the world
         void removeAllSystems();
 
+        /// Updates a system, recording the time taken within the
+        /// statistics and the trace of the world (if they are enabled)
+        /// \tparam TSystem The type of system you wish to update
+        /// \param system The system you wish to update
+        /// \param args The arguments to the update function of the system
+        /// \note This is equivalent to calling system.update(args...)
+        /// if neither statistics nor tracing are enabled
+        template <typename TSystem, typename... Args>
+        void updateSystem(TSystem& system, Args&&... args);
+
         /// Creates an Entity
         /// \return A new entity for which you can use.
         Entity createEntity();
@@ -124,6 +163,14 @@ namespace anax
         /// \return The entities you created
         EntityArray createEntities(std::size_t amount);
 
+        /// Creates a specific amount of entities from a prefab
+        /// \param prefab The prefab you wish to instantiate
+        /// \param amount The amount of entities you wish to create
+        /// \return The entities you created
+        /// \note The entities are activated, and will be added
+        /// to their systems on the next refresh
+        EntityArray instantiate(const Prefab& prefab, std::size_t amount);
+
         /// Kills and deactivates an Entity
         /// \param entity The Entity you wish to kill
         void killEntity(Entity& entity);
@@ -132,6 +179,22 @@ namespace anax
         /// \param entities The entities you wish to kill
         void killEntities(std::vector<Entity>& entities);
 
+        /// Adds a component to an array of entities
+        /// \tparam T The type of component you wish to add
+        /// \param entities The entities you wish to add the component to
+        /// \param args The arguments for the constructor of the component,
+        /// these are copied to each component
+        /// \note An entity that already has a component of this type will
+        /// have it replaced
+        template <typename T, typename... Args>
+        void addComponents(const EntityArray& entities, const Args&... args);
+
+        /// Removes a component from an array of entities
+        /// \tparam T The type of component you wish to remove
+        /// \param entities The entities you wish to remove the component from
+        template <typename T>
+        void removeComponents(const EntityArray& entities);
+
         /// Activates an Entity
         /// \param entity The Entity you wish to activate
         void activateEntity(Entity& entity);
@@ -152,9 +215,50 @@ namespace anax
         /// \return true if the Entity is valid within the World
         bool isValid(const Entity& entity) const;
 
+        /// Determines if the Entity an EntityHandle refers to is valid.
+        /// \return true if the handle refers to a valid Entity within the World
+        bool isValid(const EntityHandle& handle) const;
+
+        /// Sets the parent of an Entity
+        /// \param child The Entity you wish to set the parent of
+        /// \param parent The parent of the Entity
+        /// \note Killing an Entity will kill all of its descendants
+        /// on the next refresh
+        void setParent(const Entity& child, const Entity& parent);
+
+        /// Removes the parent of an Entity
+        /// \param child The Entity you wish to remove the parent of
+        void removeParent(const Entity& child);
+
+        /// \param entity The Entity you wish to get the parent of
+        /// \return The parent of the Entity, or a null handle if the
+        /// Entity does not have a parent
+        Entity getParent(const Entity& entity);
+
+        /// \param entity The Entity you wish to get the children of
+        /// \return The children of the Entity
+        EntityArray getChildren(const Entity& entity);
+
+        /// \return The entities that have a parent or children, ordered
+        /// by their depth within the hierarchy. Parents always come
+        /// before their children, and the children of an Entity are
+        /// contiguous, thus propagating data from parents to children
+        /// (e.g. transforms) can be done with a single pass.
+        const HierarchyArray& getHierarchy();
+
         /// Refreshes the World
         void refresh();
 
+        /// Moves the alive entities with the highest indices to the lowest
+        /// free indices, so that the entities are within a dense range of
+        /// indices. The world is refreshed beforehand.
+        /// \param maxMoves The maximum amount of entities to move, which
+        /// may be used to compact the world over several frames
+        /// \return The old and new IDs of the moved entities
+        /// \note The old IDs of the moved entities are invalidated, use
+        /// the returned table to update the entities you hold
+        EntityIdRemap compact(std::size_t maxMoves = static_cast<std::size_t>(-1));
+
         /// Instantaneously clears the world, by removing
         /// all systems and entities from the world.
         /// \note It is no guarantee that the entities from the world
@@ -169,7 +273,20 @@ namespace anax
         std::size_t getEntityCount() const;
 
         /// \return All the entities within the world
-        const EntityArray& getEntities() const;
+        EntityRange getEntities() const;
+
+        /// \return The layout of the IDs of the entities within the world
+        const EntityIdLayout& getEntityIdLayout() const;
+
+        /// \return How the indices of killed entities are re-used
+        const EntityIdRecycling& getEntityIdRecycling() const;
+
+        /// \return The amount of entity indices which have been retired,
+        /// as their counter reached the maximum of the layout
+        std::size_t getRetiredEntityIndexCount() const;
+
+        /// \return Handles to all the entities within the world
+        const EntityHandleArray& getEntityHandles() const;
 
         /// \return The entity with the associated index
         /// \note This will cause an assertion if it does not exist
@@ -177,6 +294,26 @@ namespace anax
         /// to the world
         Entity getEntity(std::size_t index);
 
+        /// \return The statistics of the world
+        /// \note Statistics are only collected if anax is built with
+        /// ANAX_ENABLE_STATS, otherwise they are always zero
+        const WorldStats& getStats() const;
+
+        /// Resets the statistics of the world
+        void resetStats();
+
+        /// \return The memory used by the storage of the world
+        WorldMemoryReport getMemoryReport() const;
+
+#ifdef ANAX_ENABLE_TRACING
+        /// Sets the recorder that refreshes and system updates are traced to
+        /// \param recorder The recorder, or nullptr to stop tracing
+        void setTraceRecorder(util::TraceRecorder* recorder);
+
+        /// \return The recorder that refreshes and system updates are traced to
+        util::TraceRecorder* getTraceRecorder() const;
+#endif // ANAX_ENABLE_TRACING
+
     private:
 
         /// Systems attached with the world.
@@ -185,6 +322,9 @@ namespace anax
         /// A pool storage of the IDs for the entities within the world
         detail::EntityIdPool m_entityIdPool;
 
+        /// The parent/child relationships of the entities
+        detail::EntityHierarchy m_hierarchy;
+
         struct EntityAttributes
         {
             // todo: possibly move component storage to single attribute?
@@ -196,9 +336,9 @@ namespace anax
 
                 /// a bitset that resembles if the entity
                 /// exists in a specific system.
-                /// The index specifies what system, 0 resembles
-                /// it is in the system, 1 is out of the system
-                std::vector<bool> systems;
+                /// The index specifies what system, 1 resembles
+                /// it is in the system, 0 is out of the system
+                std::bitset<MAX_AMOUNT_OF_SYSTEMS> systems;
             };
 
             explicit EntityAttributes(std::size_t amountOfEntities) :     
@@ -237,22 +377,27 @@ namespace anax
         struct EntityCache
         {
             /// Contains all the alive entities
-            EntityArray alive;
+            EntityHandleArray alive;
 
             /// A temporary storage for the killed entities
             /// for the world. This array gets cleared every call
             /// to refresh.
-            EntityArray killed;
+            EntityHandleArray killed;
 
             /// A temporary storage for the activated entities
             /// for the world. This array gets cleared every call
             /// to refresh.
-            EntityArray activated;
+            EntityHandleArray activated;
 
             /// A temporary storage for the deactivated entities
             /// for the world. This array gets cleared every call
             /// to refresh.
-            EntityArray deactivated;
+            EntityHandleArray deactivated;
+
+            /// Marks the indices of the entities killed within a
+            /// call to refresh, so they are removed from the alive
+            /// array within one pass.
+            std::vector<bool> isKilled;
 
             /// Clears the temporary cache
             void clearTemp()
@@ -266,6 +411,7 @@ namespace anax
             void clear()
             {
                 alive.clear();
+                isKilled.clear();
                 clearTemp();
             }
         }
@@ -276,17 +422,71 @@ namespace anax
         m_entityCache;
 
 
+#ifdef ANAX_ENABLE_STATS
+        /// The statistics of the world
+        WorldStats m_stats;
+#endif // ANAX_ENABLE_STATS
+
+#ifdef ANAX_ENABLE_TRACING
+        /// The recorder the world is traced to
+        util::TraceRecorder* m_traceRecorder;
+#endif // ANAX_ENABLE_TRACING
+
         void checkForResize(std::size_t amountOfEntitiesToBeAllocated);
         void resize(std::size_t amount);
 
         void addSystem(detail::BaseSystem& system, detail::TypeId systemTypeId);
-        void removeSystem(detail::TypeId systemTypeId);     
+        void removeSystem(detail::TypeId systemTypeId);
+
+        /// Changes the entity version of the systems an entity is within,
+        /// as components of the entity have been added, removed or replaced
+        /// \param entity The entity whose components have changed
+        void onComponentsChanged(const Entity& entity);
+
+        /// \param entities The entities whose components have changed
+        void onComponentsChanged(const EntityArray& entities);
+
+        /// \param systems The systems to change the entity version of
+        void onComponentsChanged(const std::bitset<MAX_AMOUNT_OF_SYSTEMS>& systems);
+#if defined(ANAX_ENABLE_STATS) || defined(ANAX_ENABLE_TRACING)
+        void onSystemUpdated(const detail::BaseSystem& system, detail::TypeId systemTypeId, const char* systemTypeName,
+                             std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+#endif // ANAX_ENABLE_STATS || ANAX_ENABLE_TRACING
         bool doesSystemExist(detail::TypeId systemTypeId) const;
 
         // to access components
         friend class Entity;
     };
 
+    template <typename T, typename... Args>
+    void World::addComponents(const EntityArray& entities, const Args&... args)
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot add T to entities");
+
+        auto componentTypeId = ComponentTypeId<T>();
+        auto& storage = m_entityAttributes.componentStorage;
+        auto& pool = storage.reserveComponents(entities, componentTypeId, detail::GetComponentTypeInfo<T>());
+
+        for(auto& entity : entities)
+        {
+            // the memory is given back to the pool if the constructor throws
+            std::unique_ptr<void, detail::ComponentPool::Deallocator> memory{pool.allocate(), detail::ComponentPool::Deallocator{&pool}};
+            auto component = new (memory.get()) T{args...};
+            memory.release();
+            storage.setComponent(entity, component, componentTypeId);
+        }
+
+        onComponentsChanged(entities);
+    }
+
+    template <typename T>
+    void World::removeComponents(const EntityArray& entities)
+    {
+        static_assert(IsComponent<T>(), "T is not a component, cannot remove T from entities");
+        m_entityAttributes.componentStorage.removeComponents(entities, ComponentTypeId<T>());
+        onComponentsChanged(entities);
+    }
+
     template <class TSystem>
     void World::addSystem(TSystem& system)
     { 
@@ -308,6 +508,20 @@ namespace anax
         return doesSystemExist(SystemTypeId<TSystem>());
     }
 
+    template <typename TSystem, typename... Args>
+    void World::updateSystem(TSystem& system, Args&&... args)
+    {
+        static_assert(std::is_base_of<detail::BaseSystem, TSystem>(), "Template argument does not inherit from BaseSystem"); 
+
+#if defined(ANAX_ENABLE_STATS) || defined(ANAX_ENABLE_TRACING)
+        auto start = std::chrono::steady_clock::now();
+        system.update(std::forward<Args>(args)...);
+        onSystemUpdated(system, SystemTypeId<TSystem>(), typeid(TSystem).name(), start, std::chrono::steady_clock::now());
+#else
+        system.update(std::forward<Args>(args)...);
+#endif // ANAX_ENABLE_STATS || ANAX_ENABLE_TRACING
+    }
+
     template <class TSystem>
     bool World::doesSystemExist(const TSystem& system) const
     { 
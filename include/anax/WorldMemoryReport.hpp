@@ -0,0 +1,163 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_WORLDMEMORYREPORT_HPP
+#define ANAX_WORLDMEMORYREPORT_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <anax/detail/MemoryUsage.hpp>
+
+#include <anax/Component.hpp>
+#include <anax/System.hpp>
+
+namespace anax
+{
+    /// \brief Describes the memory used by a World
+    ///
+    /// The reported memory is the heap memory owned by the storage
+    /// of the world, memory owned by components or systems themselves
+    /// (e.g. a std::string within a component) is not included.
+    ///
+    /// \see World::getMemoryReport
+    ///
+    /// \author Miguel Martin
+    struct WorldMemoryReport
+    {
+        /// Describes the amount of memory used by a container
+        typedef detail::MemoryUsage MemoryUsage;
+
+        /// \brief The memory used by a single type of component
+        struct ComponentMemory
+        {
+            ComponentMemory() :
+                typeId(0), stride(0), instanceCount(0), capacity(0), fragmentation(0)
+            {
+            }
+
+            /// The type ID of the component
+            detail::TypeId typeId;
+
+            /// The size of each component (in bytes), including padding
+            std::size_t stride;
+
+            /// The amount of components alive
+            std::size_t instanceCount;
+
+            /// The amount of components memory is reserved for
+            std::size_t capacity;
+
+            /// The memory of the pool of the components
+            MemoryUsage memory;
+
+            /// The fraction of the reserved components that are
+            /// not alive, from 0 (every component is used) to 1
+            double fragmentation;
+        };
+
+        /// \brief The memory used by a system
+        struct SystemMemory
+        {
+            SystemMemory() : typeId(0), entityCount(0) {}
+
+            /// The type ID of the system
+            detail::TypeId typeId;
+
+            /// The amount of entities within the system
+            std::size_t entityCount;
+
+            /// The memory of the entity arrays of the system, and of anything
+            /// it caches for its entities (e.g. the tuples of a CachedSystem)
+            MemoryUsage memory;
+        };
+
+        /// \tparam TComponent The type of component you wish to retrieve the memory of
+        /// \return The memory used by the component type, or nullptr if
+        /// no component of that type has been allocated
+        template <typename TComponent>
+        const ComponentMemory* getComponentMemory() const
+        {
+            for(auto& component : components)
+            {
+                if(component.typeId == ComponentTypeId<TComponent>())
+                    return &component;
+            }
+            return nullptr;
+        }
+
+        /// \tparam TSystem The type of system you wish to retrieve the memory of
+        /// \return The memory used by the system, or nullptr if it is not within the world
+        template <typename TSystem>
+        const SystemMemory* getSystemMemory() const
+        {
+            for(auto& system : systems)
+            {
+                if(system.typeId == SystemTypeId<TSystem>())
+                    return &system;
+            }
+            return nullptr;
+        }
+
+        /// \return The total memory used by the world
+        MemoryUsage getTotal() const
+        {
+            MemoryUsage total = entityIdPool;
+            total += entityAttributes;
+            total += componentEntries;
+            total += entityCache;
+            total += hierarchy;
+            for(auto& component : components)
+                total += component.memory;
+            for(auto& system : systems)
+                total += system.memory;
+            return total;
+        }
+
+        /// The memory used by each type of component, ordered by type ID
+        std::vector<ComponentMemory> components;
+
+        /// The memory used by each system
+        std::vector<SystemMemory> systems;
+
+        /// The memory used by the pool of entity IDs
+        MemoryUsage entityIdPool;
+
+        /// The memory used by the attributes of each entity
+        MemoryUsage entityAttributes;
+
+        /// The memory used to map each entity to its components
+        MemoryUsage componentEntries;
+
+        /// The memory used by the arrays of alive, activated,
+        /// deactivated and killed entities, and the marks of killed entities
+        MemoryUsage entityCache;
+
+        /// The memory used by the hierarchy of entities
+        MemoryUsage hierarchy;
+    };
+}
+
+#endif // ANAX_WORLDMEMORYREPORT_HPP
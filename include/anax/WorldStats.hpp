@@ -0,0 +1,153 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_WORLDSTATS_HPP
+#define ANAX_WORLDSTATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+
+#include <anax/Config.hpp>
+#include <anax/System.hpp>
+
+namespace anax
+{
+    /// \brief Statistics of a World, used to find where the time of a frame is spent
+    ///
+    /// Statistics are only collected if anax is built with
+    /// ANAX_ENABLE_STATS. Otherwise, every statistic stays zero and
+    /// collecting them has no cost.
+    ///
+    /// \author Miguel Martin
+    struct WorldStats
+    {
+        /// Describes a length of time
+        typedef std::chrono::nanoseconds Duration;
+
+        /// \brief Statistics of calls to World::refresh
+        struct RefreshStats
+        {
+            RefreshStats() :
+                activatedTime(0), deactivatedTime(0), killedTime(0), totalTime(0),
+                activatedCount(0), deactivatedCount(0), killedCount(0),
+                filterChecks(0), systemAdds(0), systemRemoves(0)
+            {
+            }
+
+            RefreshStats& operator+=(const RefreshStats& stats)
+            {
+                activatedTime += stats.activatedTime;
+                deactivatedTime += stats.deactivatedTime;
+                killedTime += stats.killedTime;
+                totalTime += stats.totalTime;
+                activatedCount += stats.activatedCount;
+                deactivatedCount += stats.deactivatedCount;
+                killedCount += stats.killedCount;
+                filterChecks += stats.filterChecks;
+                systemAdds += stats.systemAdds;
+                systemRemoves += stats.systemRemoves;
+                return *this;
+            }
+
+            /// The time spent adding activated entities to systems
+            Duration activatedTime;
+
+            /// The time spent removing deactivated entities from systems
+            Duration deactivatedTime;
+
+            /// The time spent destroying killed entities
+            Duration killedTime;
+
+            /// The time spent within refresh
+            Duration totalTime;
+
+            /// The amount of entities activated
+            std::size_t activatedCount;
+
+            /// The amount of entities deactivated (including killed entities)
+            std::size_t deactivatedCount;
+
+            /// The amount of entities killed
+            std::size_t killedCount;
+
+            /// The amount of times an entity was checked against the filter of a system
+            std::size_t filterChecks;
+
+            /// The amount of times an entity was added to a system
+            std::size_t systemAdds;
+
+            /// The amount of times an entity was removed from a system
+            std::size_t systemRemoves;
+        };
+
+        /// \brief Statistics of the updates of a system
+        /// \see World::updateSystem
+        struct SystemStats
+        {
+            SystemStats() :
+                lastUpdateTime(0), totalUpdateTime(0), updateCount(0), entityCount(0)
+            {
+            }
+
+            /// The time spent within the last update
+            Duration lastUpdateTime;
+
+            /// The time spent within every update
+            Duration totalUpdateTime;
+
+            /// The amount of updates
+            std::size_t updateCount;
+
+            /// The amount of entities within the system, as of the last update
+            std::size_t entityCount;
+        };
+
+        WorldStats() : refreshCount(0) {}
+
+        /// \tparam TSystem The type of system you wish to retrieve the statistics of
+        /// \return The statistics of the system, or nullptr if it has not been updated
+        template <typename TSystem>
+        const SystemStats* getSystemStats() const
+        {
+            auto it = systems.find(SystemTypeId<TSystem>());
+            return it != systems.end() ? &it->second : nullptr;
+        }
+
+        /// The statistics of the last refresh
+        RefreshStats lastRefresh;
+
+        /// The statistics of every refresh
+        RefreshStats totalRefresh;
+
+        /// The amount of refreshes
+        std::size_t refreshCount;
+
+        /// The statistics of each system, keyed by the type ID of the system
+        std::unordered_map<detail::TypeId, SystemStats> systems;
+    };
+}
+
+#endif // ANAX_WORLDSTATS_HPP
@@ -54,5 +54,7 @@ namespace anax
 #define ANAX_VERSION_NUMBER ANAX_VERSION_MAJOR.ANAX_VERSION_MINOR.ANAX_PATCH_NUMBER
 
 #include <anax/World.hpp>
+#include <anax/ComponentRegistry.hpp>
+#include <anax/StaticWorld.hpp>
 
 #endif // ANAX_HPP
@@ -0,0 +1,77 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_ALIGNEDMEMORY_HPP
+#define ANAX_DETAIL_ALIGNEDMEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <anax/detail/AnaxAssert.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// Allocates memory with an alignment, which may be greater than
+        /// the alignment operator new guarantees (alignof(std::max_align_t))
+        /// \param size The amount of bytes to allocate
+        /// \param alignment The alignment of the memory, which must be a power of two
+        /// \return The memory, which must be freed with FreeAligned()
+        inline void* AllocateAligned(std::size_t size, std::size_t alignment)
+        {
+            ANAX_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+
+            // the address of the allocation is stored just before the aligned memory
+            auto allocation = static_cast<char*>(::operator new(size + alignment + sizeof(void*)));
+            auto address = reinterpret_cast<std::uintptr_t>(allocation + sizeof(void*));
+            auto memory = reinterpret_cast<char*>((address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+            reinterpret_cast<void**>(memory)[-1] = allocation;
+            return memory;
+        }
+
+        /// Frees memory allocated with AllocateAligned()
+        /// \param memory The memory to free, which may be null
+        inline void FreeAligned(void* memory)
+        {
+            if(memory)
+            {
+                ::operator delete(static_cast<void**>(memory)[-1]);
+            }
+        }
+
+        /// \brief Frees memory allocated with AllocateAligned(), for use with std::unique_ptr
+        struct AlignedDeleter
+        {
+            void operator()(void* memory) const
+            {
+                FreeAligned(memory);
+            }
+        };
+    }
+}
+
+#endif // ANAX_DETAIL_ALIGNEDMEMORY_HPP
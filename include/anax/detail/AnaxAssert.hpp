@@ -46,4 +46,12 @@ namespace anax
 #define ANAX_ASSERT(condition, failMessage) if(!(condition)) throw anax::TestException{std::string{"assertion failed: "} + std::string{__FILE__} + std::string{": "} + std::to_string(__LINE__) + " " + std::string{__func__} + " " + std::string{failMessage}};
 #endif // ANAX_TEST_CASES
 
+// determines if ANAX_ASSERT checks its condition, so that code which
+// only exists to be asserted on may be compiled out with it
+#if defined(ANAX_TEST_CASE_BUILD) || !defined(NDEBUG)
+#   define ANAX_ASSERTS_ENABLED 1
+#else
+#   define ANAX_ASSERTS_ENABLED 0
+#endif
+
 #endif // ANAX_DETAIL_ANAXASSERT_HPP
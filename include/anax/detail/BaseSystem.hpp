@@ -28,12 +28,16 @@
 
 #include <vector>
 #include <anax/Entity.hpp>
+#include <anax/EntityHandle.hpp>
+#include <anax/EntityRange.hpp>
 
 #include <anax/detail/Filter.hpp>
+#include <anax/detail/MemoryUsage.hpp>
 
 namespace anax
 {
     class World;
+    class EntityIdRemap;
 
     namespace detail
     {
@@ -47,6 +51,17 @@ namespace anax
         {
         public:
 
+            /// The order in which the entities of a system are kept
+            enum class EntityOrder
+            {
+                /// In the order they were added to the system
+                ACTIVATION,
+
+                /// By the index of their IDs, so iterating over the
+                /// entities walks forwards through their component entries
+                INDEX
+            };
+
             BaseSystem(const Filter& filter);
 
             /// Destructor
@@ -59,7 +74,28 @@ namespace anax
             World& getWorld() const;
 
             /// \return All the entities that are within the System
-            const std::vector<Entity>& getEntities() const;
+            EntityRange getEntities() const;
+
+            /// \return Handles to all the entities that are within the System
+            const std::vector<EntityHandle>& getEntityHandles() const;
+
+            /// Sets the order in which the entities of the system are kept
+            /// \param order The order of the entities
+            /// \note The entities already within the system are re-ordered immediately
+            void setEntityOrder(EntityOrder order);
+
+            /// \return The order in which the entities of the system are kept
+            EntityOrder getEntityOrder() const;
+
+            /// \return A number which changes once per refresh if the entities
+            /// of the system have changed, or an entity within the system has
+            /// been activated again, and whenever components of an entity
+            /// within the system are added, removed or replaced
+            std::size_t getEntityVersion() const;
+
+            /// \return The heap memory used by the entity arrays of the
+            /// system, and by anything it caches for its entities
+            MemoryUsage getMemoryUsage() const;
 
         private:
 
@@ -68,12 +104,29 @@ namespace anax
 
             /// Occurs when an Entity is added to the system
             /// \param entity The Entity that is added to the system
+            /// \note Called while the world is refreshed, once the entity
+            /// is within the entities of the system
             virtual void onEntityAdded(Entity& entity) {}
 
             /// Occurs when an Entity is removed to the system
             /// \param entity The Entity that is removed from the system
+            /// \note Called while the world is refreshed, once the entity is
+            /// no longer within the entities of the system. A killed entity is
+            /// still valid and keeps its components until the callback returns.
             virtual void onEntityRemoved(Entity& entity) {}
 
+            /// Occurs when World::compact moves entities of the system to
+            /// other indices, after the entities of the system are remapped.
+            /// Anything the system keeps by entity ID or index must be updated.
+            /// \param The entities that were moved, which may include
+            /// entities that are not within the system
+            virtual void onEntitiesRemapped(const EntityIdRemap&) {}
+
+            /// \return The heap memory used by anything the system
+            /// caches for its entities, which is reported with the
+            /// memory of the system
+            virtual MemoryUsage getCacheMemoryUsage() const { return MemoryUsage(); }
+
 
 
             /// Used to add an Entity to the system
@@ -86,6 +139,22 @@ namespace anax
             /// \note This is called by the attached World object
             void remove(Entity& entity);
 
+            /// Used when an Entity within the system is activated again
+            /// \note This is called by the attached World object
+            void reactivate();
+
+            /// Applies the entities added and removed since the last call,
+            /// so the entities of the system are updated once per refresh
+            /// \note This is called by the attached World object
+            void applyChanges();
+
+            /// Merges the added entities into the entities of the system,
+            /// which are sorted by index
+            void mergeAddedEntities();
+
+            /// Sorts the entities of the system if they are kept by index
+            void sortEntities();
+
             /// Used to set the attached World
             /// \param world The World to attach to
             /// \note This is called by the attached World object
@@ -99,7 +168,26 @@ namespace anax
             Filter m_filter;
 
             /// The Entities that are attached to this system
-            std::vector<Entity> m_entities;
+            std::vector<EntityHandle> m_entities;
+
+            /// The Entities added to the system since the last call to applyChanges()
+            std::vector<EntityHandle> m_addedEntities;
+
+            /// The Entities removed from the system since the last call to applyChanges()
+            std::vector<EntityHandle> m_removedEntities;
+
+            /// Marks the indices of the removed Entities while applying changes
+            std::vector<bool> m_isRemoved;
+
+            /// The order the Entities are kept in
+            EntityOrder m_entityOrder;
+
+            /// Determines if an Entity within the system has been
+            /// activated again since the last call to applyChanges()
+            bool m_hasReactivatedEntities;
+
+            /// The version of the Entities within the system
+            std::size_t m_entityVersion;
 
             friend World;
         };
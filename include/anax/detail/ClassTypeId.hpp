@@ -27,7 +27,11 @@
 #define ANAX_DETAIL_CLASSTYPEID_HPP
 
 #include <cstddef>
-#include <atomic>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include <anax/detail/AnaxAssert.hpp>
 
 namespace anax
 {
@@ -35,6 +39,9 @@ namespace anax
     {
         typedef std::size_t TypeId;
 
+        /// Describes a type ID that has not been assigned
+        constexpr TypeId INVALID_TYPE_ID = std::numeric_limits<TypeId>::max();
+
         template <typename TBase>
         class ClassTypeId
         {
@@ -43,17 +50,123 @@ namespace anax
             template <typename T>
             static TypeId GetTypeId()
             {
-                static const TypeId id = m_nextTypeId++;
+                static const TypeId id = AssignTypeId<T>();
                 return id;
             }
 
+            /// Registers the type ID of a type, instead of assigning
+            /// the next available type ID to it once it is first used
+            /// \tparam T The type you wish to register
+            /// \param id The type ID of the type
+            /// \return false if the type ID is assigned to another type, or
+            /// the type was already assigned a different type ID
+            /// \note A type must be registered before its type ID is first used
+            template <typename T>
+            static bool RegisterTypeId(TypeId id)
+            {
+                auto& assignments = GetAssignments();
+                std::lock_guard<std::mutex> lock{assignments.mutex};
+
+                auto& registration = Registration<T>::value;
+                if(registration.id == id)
+                {
+                    return true;
+                }
+
+                ANAX_ASSERT(!registration.isUsed, "type ID is registered after it was used");
+                ANAX_ASSERT(registration.id == INVALID_TYPE_ID, "type is already registered with another type ID");
+                ANAX_ASSERT(!assignments.isAssigned(id), "type ID is already assigned to another type");
+
+                if(registration.isUsed || registration.id != INVALID_TYPE_ID || assignments.isAssigned(id))
+                {
+                    return false;
+                }
+
+                assignments.assign(id);
+                registration.id = id;
+                return true;
+            }
+
         private:
 
-            static std::atomic<TypeId> m_nextTypeId;
+            struct TypeIdRegistration
+            {
+                /// The registered type ID, or INVALID_TYPE_ID
+                TypeId id;
+
+                /// Determines if the type ID has been used
+                bool isUsed;
+            };
+
+            template <typename T>
+            struct Registration
+            {
+                static TypeIdRegistration value;
+            };
+
+            /// \brief The type IDs which are assigned to a type
+            struct Assignments
+            {
+                Assignments() : nextTypeId(0) {}
+
+                bool isAssigned(TypeId id) const
+                {
+                    return id < assigned.size() && assigned[id];
+                }
+
+                void assign(TypeId id)
+                {
+                    if(id >= assigned.size())
+                    {
+                        assigned.resize(id + 1);
+                    }
+                    assigned[id] = true;
+                }
+
+                std::mutex mutex;
+
+                /// Determines if each type ID is assigned
+                std::vector<bool> assigned;
+
+                /// The lowest type ID which may not be assigned
+                TypeId nextTypeId;
+            };
+
+            /// \return The type IDs which are assigned, constructed on
+            /// first use so types may be used during static initialisation
+            static Assignments& GetAssignments()
+            {
+                static Assignments assignments;
+                return assignments;
+            }
+
+            template <typename T>
+            static TypeId AssignTypeId()
+            {
+                auto& assignments = GetAssignments();
+                std::lock_guard<std::mutex> lock{assignments.mutex};
+
+                auto& registration = Registration<T>::value;
+                registration.isUsed = true;
+                if(registration.id != INVALID_TYPE_ID)
+                {
+                    return registration.id;
+                }
+
+                // skip the type IDs registered to other types
+                while(assignments.isAssigned(assignments.nextTypeId))
+                {
+                    ++assignments.nextTypeId;
+                }
+
+                assignments.assign(assignments.nextTypeId);
+                return assignments.nextTypeId++;
+            }
         };
 
         template <typename TBase>
-        std::atomic<TypeId> ClassTypeId<TBase>::m_nextTypeId{0};
+        template <typename T>
+        typename ClassTypeId<TBase>::TypeIdRegistration ClassTypeId<TBase>::Registration<T>::value = { INVALID_TYPE_ID, false };
     }
 }
 
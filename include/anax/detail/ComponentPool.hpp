@@ -0,0 +1,143 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_COMPONENTPOOL_HPP
+#define ANAX_DETAIL_COMPONENTPOOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <anax/detail/AlignedMemory.hpp>
+#include <anax/detail/ComponentTypeInfo.hpp>
+#include <anax/detail/MemoryUsage.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// \brief A pool of memory for a single type of component
+        ///
+        /// Memory is allocated in chunks, which are never moved once
+        /// allocated. Therefore pointers to components remain valid until
+        /// the component is destroyed. Each component is aligned to the
+        /// alignment of its type, which may exceed the alignment that
+        /// operator new guarantees.
+        ///
+        /// \author Miguel Martin
+        class ComponentPool
+        {
+        public:
+
+            /// \param typeInfo The type of component to pool
+            explicit ComponentPool(const ComponentTypeInfo& typeInfo);
+
+            ComponentPool(const ComponentPool&) = delete;
+            ComponentPool(ComponentPool&&) = delete;
+            ComponentPool& operator=(const ComponentPool&) = delete;
+            ComponentPool& operator=(ComponentPool&&) = delete;
+
+            /// Retrieves uninitialised memory for a component
+            /// \return The memory for the component
+            void* allocate();
+
+            /// Destroys a component and gives its memory back to the pool
+            /// \param component The component you wish to destroy
+            void destroy(void* component);
+
+            /// Gives memory back to the pool, without destroying a component
+            /// \param memory Memory retrieved from allocate, which does
+            /// not contain a component (e.g. its constructor threw)
+            void deallocate(void* memory);
+
+            /// \brief Gives memory back to a pool, to be used with std::unique_ptr
+            struct Deallocator
+            {
+                ComponentPool* pool;
+
+                void operator()(void* memory) const
+                {
+                    pool->deallocate(memory);
+                }
+            };
+
+            /// Ensures memory for an amount of components is available,
+            /// without requiring any further allocations
+            /// \param amount The amount of components to reserve memory for
+            void reserve(std::size_t amount);
+
+            /// \return The type of component this pool stores
+            const ComponentTypeInfo& getTypeInfo() const;
+
+            /// \return The amount of components alive within the pool
+            std::size_t getSize() const;
+
+            /// \return The amount of components the pool can store
+            std::size_t getCapacity() const;
+
+            /// \return The size of each component within the pool (in bytes),
+            /// including the padding required for alignment
+            std::size_t getStride() const;
+
+            /// \return The memory used by the pool, the used bytes
+            /// are the bytes of the alive components and the book-keeping
+            /// of the pool
+            MemoryUsage getMemoryUsage() const;
+
+        private:
+
+            struct Chunk
+            {
+                /// The memory of the chunk
+                std::unique_ptr<char[], AlignedDeleter> memory;
+
+                /// The amount of components the chunk can store
+                std::size_t capacity;
+            };
+
+            /// Allocates a new chunk of memory
+            /// \param capacity The amount of components the chunk can store
+            void addChunk(std::size_t capacity);
+
+            /// The type of component within this pool
+            const ComponentTypeInfo* m_typeInfo;
+
+            /// The size of each element within a chunk
+            std::size_t m_stride;
+
+            /// The total amount of components the pool can store
+            std::size_t m_capacity;
+
+            /// The chunks of memory owned by the pool
+            std::vector<Chunk> m_chunks;
+
+            /// The memory that is available to be used, the back
+            /// of this array is the next memory to be used
+            std::vector<void*> m_freeList;
+        };
+    }
+}
+
+#endif // ANAX_DETAIL_COMPONENTPOOL_HPP
@@ -0,0 +1,166 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_COMPONENTTYPEINFO_HPP
+#define ANAX_DETAIL_COMPONENTTYPEINFO_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace anax
+{
+    class Component;
+
+    namespace detail
+    {
+        /// \brief Describes how to manage the memory of a component type
+        ///
+        /// Component storage is type-erased, thus this is used to
+        /// copy, move and destroy components without knowing their
+        /// type. As a result components are not required to derive
+        /// from Component, or to have a virtual destructor.
+        ///
+        /// \author Miguel Martin
+        struct ComponentTypeInfo
+        {
+            typedef void (*DestroyFunction)(void* component);
+            typedef void (*CopyFunction)(void* destination, const void* source);
+            typedef void (*MoveFunction)(void* destination, void* source);
+            typedef Component* (*ToComponentFunction)(void* component);
+
+            /// The size of the component (in bytes)
+            std::size_t size;
+
+            /// The alignment of the component (in bytes)
+            std::size_t alignment;
+
+            /// Determines if the component may be copied with memcpy
+            bool isTriviallyCopyable;
+
+            /// Determines if destroying the component may be skipped
+            bool isTriviallyDestructible;
+
+            /// Destroys a component (does not free its memory)
+            DestroyFunction destroy;
+
+            /// Copy constructs a component into uninitialised memory
+            /// \note This is null if the component is not copyable
+            CopyFunction copy;
+
+            /// Move constructs a component into uninitialised memory,
+            /// the source is left alive and must still be destroyed
+            /// \note This is null if the component is not movable
+            MoveFunction move;
+
+            /// Converts a pointer to the component to its Component base
+            /// \note This returns null if the component does not derive
+            /// from Component
+            ToComponentFunction toComponent;
+        };
+
+        template <class T>
+        void DestroyComponent(void* component)
+        {
+            static_cast<T*>(component)->~T();
+        }
+
+        template <class T>
+        void CopyComponent(void* destination, const void* source)
+        {
+            new (destination) T(*static_cast<const T*>(source));
+        }
+
+        template <class T>
+        void MoveComponent(void* destination, void* source)
+        {
+            new (destination) T(std::move(*static_cast<T*>(source)));
+        }
+
+        template <class T>
+        Component* ToComponent(void* component, std::true_type)
+        {
+            return static_cast<T*>(component);
+        }
+
+        template <class T>
+        Component* ToComponent(void*, std::false_type)
+        {
+            return nullptr;
+        }
+
+        template <class T>
+        Component* ToComponent(void* component)
+        {
+            return ToComponent<T>(component, typename std::is_base_of<Component, T>::type());
+        }
+
+        template <class T>
+        ComponentTypeInfo::CopyFunction MakeCopyFunction(std::true_type)
+        {
+            return &CopyComponent<T>;
+        }
+
+        template <class T>
+        ComponentTypeInfo::CopyFunction MakeCopyFunction(std::false_type)
+        {
+            return nullptr;
+        }
+
+        template <class T>
+        ComponentTypeInfo::MoveFunction MakeMoveFunction(std::true_type)
+        {
+            return &MoveComponent<T>;
+        }
+
+        template <class T>
+        ComponentTypeInfo::MoveFunction MakeMoveFunction(std::false_type)
+        {
+            return nullptr;
+        }
+
+        /// \tparam T The type of component
+        /// \return The type information for a component type
+        template <class T>
+        const ComponentTypeInfo& GetComponentTypeInfo()
+        {
+            static const ComponentTypeInfo info = 
+            {
+                sizeof(T),
+                alignof(T),
+                std::is_trivially_copyable<T>::value,
+                std::is_trivially_destructible<T>::value,
+                &DestroyComponent<T>,
+                MakeCopyFunction<T>(typename std::is_copy_constructible<T>::type()),
+                MakeMoveFunction<T>(typename std::is_move_constructible<T>::type()),
+                &ToComponent<T>
+            };
+            return info;
+        }
+    }
+}
+
+#endif // ANAX_DETAIL_COMPONENTTYPEINFO_HPP
@@ -28,9 +28,13 @@
 
 #include <memory>
 #include <array>
+#include <vector>
 
 #include <anax/detail/ClassTypeId.hpp>
 #include <anax/detail/ComponentTypeList.hpp>
+#include <anax/detail/ComponentTypeInfo.hpp>
+#include <anax/detail/ComponentPool.hpp>
+#include <anax/detail/MemoryUsage.hpp>
 
 #include <anax/Entity.hpp>
 #include <anax/Component.hpp>
@@ -53,19 +57,61 @@ namespace anax
 
             explicit EntityComponentStorage(std::size_t entityAmount);
 
+            ~EntityComponentStorage();
+
             EntityComponentStorage(const EntityComponentStorage&) = delete;
             EntityComponentStorage(EntityComponentStorage&&) = delete;
             EntityComponentStorage& operator=(const EntityComponentStorage&) = delete;
             EntityComponentStorage& operator=(EntityComponentStorage&&) = delete;
 
 
-            void addComponent(Entity& entity, Component* component, TypeId componentTypeId);
+            /// Retrieves uninitialised memory for a component
+            /// \param componentTypeId The type of the component
+            /// \param typeInfo The type information of the component
+            /// \return The memory to construct the component in
+            void* allocateComponent(TypeId componentTypeId, const ComponentTypeInfo& typeInfo);
+
+            /// Gives memory retrieved from allocateComponent back to its
+            /// pool, without destroying a component within it
+            /// \param memory The memory to give back
+            /// \param componentTypeId The type of the component
+            void deallocateComponent(void* memory, TypeId componentTypeId);
+
+            /// Attaches a component, constructed within memory retrieved
+            /// from allocateComponent, to an entity
+            void addComponent(Entity& entity, void* component, TypeId componentTypeId);
+
+            /// Validates an array of entities and reserves memory for
+            /// a component of a specific type for each entity
+            /// \param entities The entities that will have the component attached
+            /// \param componentTypeId The type of the component
+            /// \param typeInfo The type information of the component
+            /// \return The pool to allocate the components from
+            ComponentPool& reserveComponents(const std::vector<Entity>& entities, TypeId componentTypeId, const ComponentTypeInfo& typeInfo);
+
+            /// Attaches a component to an entity, without validating the entity
+            /// \param entity The entity to attach the component to
+            /// \param component The component, allocated from the pool of its type
+            /// \param componentTypeId The type of the component
+            void setComponent(const Entity& entity, void* component, TypeId componentTypeId);
+
+            /// Copies a component to an array of entities
+            /// \param entities The entities to copy the component to
+            /// \param component The component you wish to copy
+            /// \param componentTypeId The type of the component
+            /// \param typeInfo The type information of the component
+            void copyComponent(const std::vector<Entity>& entities, const void* component, TypeId componentTypeId, const ComponentTypeInfo& typeInfo);
 
             void removeComponent(Entity& entity, TypeId componentTypeId);
 
+            /// Removes a component type from an array of entities
+            /// \param entities The entities to remove the component from
+            /// \param componentTypeId The type of the component
+            void removeComponents(const std::vector<Entity>& entities, TypeId componentTypeId);
+
             void removeAllComponents(Entity& entity);
 
-            Component& getComponent(const Entity& entity, TypeId componentTypeId) const;
+            void* getComponent(const Entity& entity, TypeId componentTypeId) const;
 
             ComponentTypeList getComponentTypeList(const Entity& entity) const;
 
@@ -73,13 +119,27 @@ namespace anax
 
             bool hasComponent(const Entity& entity, TypeId componentTypeId) const;
 
+            /// \return The pools of memory for each type of component. The
+            /// index of this array is the TypeId of the component, and is
+            /// null if no component of that type has been allocated
+            const std::vector<std::unique_ptr<ComponentPool>>& getComponentPools() const;
+
+            /// \return The memory used to map entities to their components
+            /// \note The memory of the pools is not included
+            MemoryUsage getMemoryUsage() const;
+
+            /// Moves the components of an entity to another index
+            /// \param from The ID of the entity before it is moved
+            /// \param to The ID of the entity after it is moved, which has no components
+            void move(Entity::Id from, Entity::Id to);
+
             void resize(std::size_t entityAmount);
 
             void clear();
 
         private:
 
-            typedef std::array<std::unique_ptr<Component>, anax::MAX_AMOUNT_OF_COMPONENTS> ImplComponentArray;
+            typedef std::array<void*, anax::MAX_AMOUNT_OF_COMPONENTS> ImplComponentArray;
             
             /// \brief A data structure to describe the components
             /// within an entity
@@ -87,20 +147,15 @@ namespace anax
             /// \author Miguel Martin
             struct EntityComponents
             {
-                EntityComponents() = default;
-
-                // bug in clang? won't work w/o this
-                // http://stackoverflow.com/questions/8560994/stdmake-shared-stdunique-ptr-and-move-constructors
-                // I think it's due to ComponentTypeList (may have to update boost)
-                EntityComponents(EntityComponents&& e) : 
-                    components(std::move(e.components)), 
-                    componentTypeList(std::move(e.componentTypeList))
+                EntityComponents() 
                 {
+                    components.fill(nullptr);
                 }
 
                 /// The components of an entity. The
                 /// index of this array is the same as the TypeId
-                /// of the component.
+                /// of the component. The memory of each component
+                /// is owned by the pool of its type.
                 ImplComponentArray components;
 
                 /// A list of component types, which resembles
@@ -113,6 +168,12 @@ namespace anax
             /// as the index component of an entity's ID.
             std::vector<EntityComponents> m_componentEntries;
 
+            /// The pools of memory for each type of component.
+            /// The index of this array is the TypeId of the component.
+            std::vector<std::unique_ptr<ComponentPool>> m_componentPools;
+
+            ComponentPool& getComponentPool(TypeId componentTypeId, const ComponentTypeInfo& typeInfo);
+
             ImplComponentArray& getComponentsImpl(const Entity& e);
             const ImplComponentArray& getComponentsImpl(const Entity& e) const;
         };
@@ -0,0 +1,170 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_ENTITYHIERARCHY_HPP
+#define ANAX_DETAIL_ENTITYHIERARCHY_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <anax/Entity.hpp>
+#include <anax/EntityHandle.hpp>
+#include <anax/EntityIdRemap.hpp>
+
+#include <anax/detail/MemoryUsage.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// \brief Stores parent/child relationships between entities
+        ///
+        /// The relationships are flattened into an array, ordered by depth,
+        /// where the children of an entity are contiguous. The array is
+        /// rebuilt lazily, when it is requested after a relationship changes.
+        ///
+        /// \author Miguel Martin
+        class EntityHierarchy
+        {
+        public:
+
+            /// \brief Describes an entity within the flattened hierarchy
+            struct Node
+            {
+                /// The entity
+                Entity entity;
+
+                /// The position of the parent within the flattened
+                /// hierarchy, or NO_PARENT for a root entity
+                std::size_t parent;
+            };
+
+            /// The parent of a root node
+            static const std::size_t NO_PARENT;
+
+            EntityHierarchy(World& world, std::size_t entityAmount);
+
+            EntityHierarchy(const EntityHierarchy&) = delete;
+            EntityHierarchy(EntityHierarchy&&) = delete;
+            EntityHierarchy& operator=(const EntityHierarchy&) = delete;
+            EntityHierarchy& operator=(EntityHierarchy&&) = delete;
+
+            /// Sets the parent of an entity
+            /// \param child The entity you wish to set the parent of
+            /// \param parent The parent of the entity
+            void setParent(const Entity& child, const Entity& parent);
+
+            /// Removes the parent of an entity (if it has one)
+            /// \param child The entity you wish to remove the parent of
+            void removeParent(const Entity& child);
+
+            /// \param entity The entity you wish to get the parent of
+            /// \return The ID of the parent of the entity, which is null
+            /// if the entity does not have a parent
+            Entity::Id getParent(const Entity& entity) const;
+
+            /// \param entity The entity you wish to get the children of
+            /// \return The amount of children an entity has
+            std::size_t getChildCount(const Entity& entity) const;
+
+            /// \param entity The entity you wish to get the children of
+            /// \return The position of the first child of the entity
+            /// within the flattened hierarchy
+            /// \note The remaining children follow the first child
+            std::size_t getFirstChild(const Entity& entity);
+
+            /// \return The flattened hierarchy, ordered by depth
+            const std::vector<Node>& getNodes();
+
+            /// Appends all the descendants of an entity to an array
+            /// \param entity The entity you wish to get the descendants of
+            /// \param descendants The array to append the descendants to
+            void getDescendants(const Entity& entity, std::vector<EntityHandle>& descendants);
+
+            /// Removes an entity from the hierarchy
+            /// \param entity The entity to remove
+            /// \note The children of the entity are expected
+            /// to be removed as well
+            void remove(const Entity& entity);
+
+            /// \return The memory used by the relationships and the flattened hierarchy
+            MemoryUsage getMemoryUsage() const;
+
+            /// Moves the relationships of entities to their new indices
+            /// \param remap The entities that were moved
+            void remap(const EntityIdRemap& remap);
+
+            void resize(std::size_t entityAmount);
+
+            void clear();
+
+        private:
+
+            /// \brief Describes the relationships of a single entity
+            struct Relation
+            {
+                Relation() : 
+                    childCount(0),
+                    firstChild(0)
+                {
+                }
+
+                /// The ID of the entity, used to construct handles
+                Entity::Id id;
+
+                /// The ID of the parent entity, null if there is no parent
+                Entity::Id parent;
+
+                /// The amount of children this entity has
+                std::size_t childCount;
+
+                /// The offset of the children in m_children when rebuilding, and
+                /// the position of the first child in m_nodes once rebuilt
+                std::size_t firstChild;
+            };
+
+            /// Rebuilds the flattened hierarchy
+            void rebuild();
+
+            /// The World the entities belong to
+            World* m_world;
+
+            /// The relationships of each entity, the indices of this
+            /// array is the same as the index component of an entity's ID.
+            std::vector<Relation> m_relations;
+
+            /// The flattened hierarchy
+            std::vector<Node> m_nodes;
+
+            /// Temporary storage of children grouped by parent, used to rebuild
+            std::vector<Entity::Id> m_children;
+
+            /// Determines if the flattened hierarchy requires to be rebuilt
+            bool m_isDirty;
+        };
+    }
+}
+
+#endif // ANAX_DETAIL_ENTITYHIERARCHY_HPP
@@ -29,6 +29,11 @@
 #include <vector>
 
 #include <anax/Entity.hpp>
+#include <anax/EntityIdLayout.hpp>
+#include <anax/EntityIdRecycling.hpp>
+#include <anax/EntityIdRemap.hpp>
+
+#include <anax/detail/MemoryUsage.hpp>
 
 namespace anax
 {
@@ -36,14 +41,17 @@ namespace anax
     {
         /// \brief A pool of entity IDs
         ///
-        /// Used to pool entity IDs, so they can be re-used.
+        /// Used to pool entity IDs, so they can be re-used. An
+        /// index is retired once its counter overflows the layout
+        /// of the pool, and free indices are re-used in the order
+        /// of the recycling policy of the pool.
         ///
         /// \author Miguel Martin
         class EntityIdPool
         {
         public:
 
-            explicit EntityIdPool(std::size_t poolSize);
+            EntityIdPool(std::size_t poolSize, const EntityIdLayout& layout, const EntityIdRecycling& recycling);
 
             EntityIdPool(const EntityIdPool&) = delete;
             EntityIdPool(EntityIdPool&&) = delete;
@@ -70,9 +78,32 @@ namespace anax
             /// \return true if the ID is valid
             bool isValid(Entity::Id id) const;
 
+            /// Moves the IDs with the highest indices to the lowest free
+            /// indices. The moved from IDs are removed from the pool.
+            /// \param maxMoves The maximum amount of IDs to move
+            /// \return The IDs that were moved
+            /// \note Afterwards the lowest free indices are re-used first
+            std::vector<EntityIdRemap::Move> compact(std::size_t maxMoves);
+
             /// \return The amount of entities that this pool can store
             std::size_t getSize() const;
 
+            /// \param amount The amount of IDs to create
+            /// \return The size the pool must have to create amount IDs
+            std::size_t getRequiredSize(std::size_t amount) const;
+
+            /// \return The amount of indices that have been retired
+            std::size_t getRetiredCount() const;
+
+            /// \return The layout of the IDs given out by the pool
+            const EntityIdLayout& getLayout() const;
+
+            /// \return The recycling policy of the pool
+            const EntityIdRecycling& getRecycling() const;
+
+            /// \return The memory used by the counters and the free list of the pool
+            MemoryUsage getMemoryUsage() const;
+
             /// Resizes the pool
             /// \param amount The amount you wish to resize
             void resize(std::size_t amount);
@@ -83,15 +114,47 @@ namespace anax
 
         private:
 
+            /// \return The amount of IDs within the free list
+            std::size_t getFreeCount() const;
+
+            /// Adds an ID to the free list, in the order of the recycling policy
+            void pushFreeId(Entity::Id id);
+
+            /// Takes the next ID to re-use out of the free list
+            Entity::Id popFreeId();
+
+            /// Orders the free list so the lowest indices are re-used first
+            void sortFreeList();
+
             /// The default pool size
             std::size_t m_defaultPoolSize;
 
+            /// The layout of the IDs
+            EntityIdLayout m_layout;
+
+            /// The amount of indices that will never be used again
+            std::size_t m_retiredCount;
+
+            /// The order in which free IDs are re-used
+            EntityIdRecycling m_recycling;
+
             /// The next ID to be used (if there is no IDs in the freelist)
             Entity::Id::int_type m_nextId;
 
-            /// The entities ids that are available to be used
+            /// The entities ids that are available to be used,
+            /// a stack, queue or heap depending on the recycling order
             std::vector<Entity::Id> m_freeList;
 
+            /// The first ID of the free list, which is a queue for FIFO
+            std::size_t m_freeListBegin;
+
+            /// The most recently freed IDs, which are held aside from
+            /// the free list until they leave the quarantine, oldest first
+            std::vector<Entity::Id> m_quarantine;
+
+            /// The first ID of the quarantine
+            std::size_t m_quarantineBegin;
+
             /// The Entities that are within the pool
             /// Stored as a counter and the index is the index part of the ID
             std::vector<Entity::Id::int_type> m_counts;
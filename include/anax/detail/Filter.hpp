@@ -48,11 +48,14 @@ namespace anax
         {
         public:
 
-            Filter(ComponentTypeList requirements, ComponentTypeList excludes) :
+            constexpr Filter(ComponentTypeList requirements, ComponentTypeList excludes) :
                 m_requires(requirements), m_excludes(excludes)
             { }
 
-            bool doesPassFilter(const ComponentTypeList& typeList) const;
+            bool doesPassFilter(const ComponentTypeList& typeList) const
+            {
+                return (m_requires & typeList) == m_requires && (m_excludes & typeList).none();
+            }
 
         private:
 
@@ -66,7 +69,7 @@ namespace anax
         template <class T, class... Args>
         static ComponentTypeList types(detail::TypeList<T, Args...> typeList)
         {
-            static_assert(std::is_base_of<Component, T>::value, "Invalid component");
+            static_assert(IsComponent<T>::value, "Invalid component");
             return ComponentTypeList().set(ComponentTypeId<T>()) | types(detail::TypeList<Args...>());
         }
 
@@ -0,0 +1,76 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_MEMORYUSAGE_HPP
+#define ANAX_DETAIL_MEMORYUSAGE_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// \brief Describes the amount of heap memory used by a container
+        ///
+        /// \author Miguel Martin
+        struct MemoryUsage
+        {
+            MemoryUsage() : usedBytes(0), reservedBytes(0) {}
+
+            MemoryUsage(std::size_t used, std::size_t reserved) : usedBytes(used), reservedBytes(reserved) {}
+
+            MemoryUsage& operator+=(const MemoryUsage& usage)
+            {
+                usedBytes += usage.usedBytes;
+                reservedBytes += usage.reservedBytes;
+                return *this;
+            }
+
+            /// The amount of bytes that hold elements
+            std::size_t usedBytes;
+
+            /// The amount of bytes allocated, including the used bytes
+            std::size_t reservedBytes;
+        };
+
+        /// \return The heap memory used by the elements of an array
+        /// \note The memory owned by the elements themselves is not included
+        template <class T, class Allocator>
+        MemoryUsage GetMemoryUsage(const std::vector<T, Allocator>& array)
+        {
+            return MemoryUsage(array.size() * sizeof(T), array.capacity() * sizeof(T));
+        }
+
+        /// \return The heap memory used by a bitset
+        template <class Allocator>
+        MemoryUsage GetMemoryUsage(const std::vector<bool, Allocator>& bits)
+        {
+            return MemoryUsage((bits.size() + 7) / 8, (bits.capacity() + 7) / 8);
+        }
+    }
+}
+
+#endif // ANAX_DETAIL_MEMORYUSAGE_HPP
@@ -0,0 +1,114 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_REPLACECOMPONENT_HPP
+#define ANAX_DETAIL_REPLACECOMPONENT_HPP
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// Determines if a component is replaced by assigning an
+        /// argument, which is the case if the only argument is a T
+        template <class T, class... Args>
+        struct IsAssignedComponent : std::false_type {};
+
+        template <class T, class Arg>
+        struct IsAssignedComponent<T, Arg> :
+            std::integral_constant<bool, std::is_same<typename std::decay<Arg>::type, T>::value &&
+                                         std::is_assignable<T&, Arg>::value> {};
+
+        /// Determines if T{args...} is valid and cannot throw, which
+        /// (unlike std::is_nothrow_constructible) also holds for aggregates
+        template <class T, class... Args>
+        struct IsNothrowBraceConstructible
+        {
+        private:
+
+            template <class U, class = decltype(U{std::declval<Args>()...})>
+            static std::integral_constant<bool, noexcept(U{std::declval<Args>()...})> test(int);
+
+            template <class U>
+            static std::false_type test(...);
+
+        public:
+
+            static constexpr bool value = decltype(test<T>(0))::value;
+        };
+
+        /// Determines if a component may be replaced within its memory.
+        /// A component that is not assigned is constructed in place if
+        /// its constructor cannot throw, otherwise a temporary is moved
+        /// into it, so the old component is kept if the constructor throws.
+        template <class T, class... Args>
+        struct IsReplacedInPlace :
+            std::integral_constant<bool, IsAssignedComponent<T, Args...>::value ||
+                                         IsNothrowBraceConstructible<T, Args...>::value ||
+                                         std::is_move_assignable<T>::value> {};
+
+        template <class T, class Arg>
+        void ReplaceComponent(T& component, std::true_type, std::false_type, Arg&& arg)
+        {
+            component = std::forward<Arg>(arg);
+        }
+
+        template <class T, class... Args>
+        void ReplaceComponent(T& component, std::false_type, std::true_type, Args&&... args)
+        {
+            component.~T();
+            new (&component) T{std::forward<Args>(args)...};
+        }
+
+        template <class T, class... Args>
+        void ReplaceComponent(T& component, std::false_type, std::false_type, Args&&... args)
+        {
+            component = T{std::forward<Args>(args)...};
+        }
+
+        /// Replaces a component within its memory
+        ///
+        /// The component is assigned if it is replaced by another T,
+        /// otherwise it is reconstructed in place (or assigned from a
+        /// temporary if construction may throw).
+        ///
+        /// \param component The component to replace
+        /// \param args The arguments for the constructor of the component
+        template <class T, class... Args>
+        void ReplaceComponent(T& component, Args&&... args)
+        {
+            static_assert(IsReplacedInPlace<T, Args...>::value, "T cannot be replaced within its memory");
+
+            typedef IsAssignedComponent<T, Args...> IsAssigned;
+            typedef std::integral_constant<bool, !IsAssigned::value && IsNothrowBraceConstructible<T, Args...>::value> IsInPlace;
+            ReplaceComponent(component, typename IsAssigned::type(), typename IsInPlace::type(), std::forward<Args>(args)...);
+        }
+    }
+}
+
+#endif // ANAX_DETAIL_REPLACECOMPONENT_HPP
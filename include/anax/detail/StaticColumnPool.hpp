@@ -0,0 +1,173 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_STATICCOLUMNPOOL_HPP
+#define ANAX_DETAIL_STATICCOLUMNPOOL_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <anax/detail/AlignedMemory.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+#include <anax/ComponentColumns.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// \brief A pool of components stored as a column per member,
+        /// indexed by the index of an entity
+        ///
+        /// Each column is aligned to COLUMN_ALIGNMENT. As the components
+        /// are not stored as objects, they are retrieved by value, and
+        /// only the members within columns are kept.
+        ///
+        /// \tparam T The type of component to pool, which specialises ComponentColumns
+        ///
+        /// \author Miguel Martin
+        template <class T>
+        class StaticColumnPool
+        {
+        public:
+
+            typedef ComponentColumns<T> Columns;
+            typedef typename Columns::ScalarType Scalar;
+
+            /// The type used to retrieve a component
+            typedef T Reference;
+
+            /// The type used to retrieve a component of a const pool
+            typedef T ConstReference;
+
+            StaticColumnPool() : m_capacity(0), m_columnStride(0) {}
+
+            StaticColumnPool(const StaticColumnPool&) = delete;
+            StaticColumnPool& operator=(const StaticColumnPool&) = delete;
+
+            /// Constructs a component
+            /// \param index The index of the entity
+            /// \param args The arguments for the constructor of the component
+            /// \return A copy of the component
+            template <class... Args>
+            T construct(std::size_t index, Args&&... args)
+            {
+                T component{std::forward<Args>(args)...};
+                set(index, component);
+                return component;
+            }
+
+            /// Destroys a component, which does nothing as only
+            /// the values of its members are stored
+            void destroy(std::size_t)
+            {
+            }
+
+            /// \param index The index of the entity
+            /// \return A copy of the component of the entity
+            T get(std::size_t index) const
+            {
+                T component{};
+                for(std::size_t column = 0; column < Columns::COLUMN_COUNT; ++column)
+                {
+                    component.*Columns::GetMember(column) = getColumn(column)[index];
+                }
+                return component;
+            }
+
+            /// Stores a component
+            /// \param index The index of the entity
+            /// \param component The component of the entity
+            void set(std::size_t index, const T& component)
+            {
+                for(std::size_t column = 0; column < Columns::COLUMN_COUNT; ++column)
+                {
+                    getColumn(column)[index] = component.*Columns::GetMember(column);
+                }
+            }
+
+            /// \param column The column
+            /// \return The values of the column, indexed by the index of an entity
+            Scalar* getColumn(std::size_t column)
+            {
+                return m_columns.get() + column * m_columnStride;
+            }
+
+            /// \param column The column
+            /// \return The values of the column, indexed by the index of an entity
+            const Scalar* getColumn(std::size_t column) const
+            {
+                return m_columns.get() + column * m_columnStride;
+            }
+
+            /// Resizes the pool, copying every column
+            /// \param capacity The amount of entities to store components for
+            /// \note Every value is copied, so which components are alive is not used
+            template <class IsAlive>
+            void resize(std::size_t capacity, IsAlive)
+            {
+                ANAX_ASSERT(capacity >= m_capacity, "pools of components cannot shrink");
+
+                // every column starts at a multiple of the alignment
+                const std::size_t scalarsPerAlignment = COLUMN_ALIGNMENT / sizeof(Scalar);
+                auto columnStride = (capacity + scalarsPerAlignment - 1) / scalarsPerAlignment * scalarsPerAlignment;
+
+                auto size = columnStride * Columns::COLUMN_COUNT * sizeof(Scalar);
+                std::unique_ptr<Scalar[], AlignedDeleter> columns{static_cast<Scalar*>(AllocateAligned(size, COLUMN_ALIGNMENT))};
+                std::memset(columns.get(), 0, size);
+
+                for(std::size_t column = 0; column < Columns::COLUMN_COUNT && m_capacity > 0; ++column)
+                {
+                    std::memcpy(columns.get() + column * columnStride, getColumn(column), m_capacity * sizeof(Scalar));
+                }
+
+                m_columns = std::move(columns);
+                m_columnStride = columnStride;
+                m_capacity = capacity;
+            }
+
+            /// \return The amount of entities the pool can store components for
+            std::size_t getCapacity() const
+            {
+                return m_capacity;
+            }
+
+        private:
+
+            /// The amount of entities the pool can store components for
+            std::size_t m_capacity;
+
+            /// The amount of values between the start of each column
+            std::size_t m_columnStride;
+
+            /// The columns, the first of which is aligned to COLUMN_ALIGNMENT
+            std::unique_ptr<Scalar[], AlignedDeleter> m_columns;
+        };
+    }
+}
+
+#endif // ANAX_DETAIL_STATICCOLUMNPOOL_HPP
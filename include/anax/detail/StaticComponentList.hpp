@@ -0,0 +1,100 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_STATICCOMPONENTLIST_HPP
+#define ANAX_DETAIL_STATICCOMPONENTLIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <anax/detail/ClassTypeId.hpp>
+#include <anax/detail/Filter.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// The index of a type within a list of types
+        template <class T, class... Types>
+        struct TypeIndex
+        {
+            static_assert(sizeof(T) == 0, "T is not within the list of types");
+        };
+
+        template <class T, class... Types>
+        struct TypeIndex<T, T, Types...> : std::integral_constant<TypeId, 0> {};
+
+        template <class T, class U, class... Types>
+        struct TypeIndex<T, U, Types...> : std::integral_constant<TypeId, 1 + TypeIndex<T, Types...>::value> {};
+
+        /// \brief A list of component types known at compile-time
+        ///
+        /// The type ID of a component is its position within the list,
+        /// thus type IDs and the masks of filters are constant expressions.
+        ///
+        /// \tparam Components The types of components
+        ///
+        /// \author Miguel Martin
+        template <class... Components>
+        struct StaticComponentList
+        {
+            /// Describes a set of component types, where bit N is the
+            /// component with the type ID N
+            typedef std::uint64_t Mask;
+
+            /// The amount of components within the list
+            static constexpr std::size_t COUNT = sizeof...(Components);
+
+            static_assert(COUNT < 64, "Too many components for a mask");
+
+            /// \tparam T The type of component
+            /// \return The type ID of the component
+            template <class T>
+            static constexpr TypeId GetTypeId()
+            {
+                return TypeIndex<T, Components...>::value;
+            }
+
+            /// \return The mask of an empty list of types
+            static constexpr Mask GetMask(TypeList<>)
+            {
+                return 0;
+            }
+
+            /// \return The mask of a list of types, e.g. Requires<A, B>
+            template <class T, class... Types>
+            static constexpr Mask GetMask(TypeList<T, Types...>)
+            {
+                return (Mask(1) << GetTypeId<T>()) | GetMask(TypeList<Types...>());
+            }
+        };
+
+        template <class... Components>
+        constexpr std::size_t StaticComponentList<Components...>::COUNT;
+    }
+}
+
+#endif // ANAX_DETAIL_STATICCOMPONENTLIST_HPP
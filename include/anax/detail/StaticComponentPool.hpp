@@ -0,0 +1,151 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_DETAIL_STATICCOMPONENTPOOL_HPP
+#define ANAX_DETAIL_STATICCOMPONENTPOOL_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <anax/detail/AlignedMemory.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// \brief A typed pool of components, indexed by the index of an entity
+        ///
+        /// The pool does not know which of its components are alive,
+        /// that is tracked by its owner.
+        ///
+        /// \tparam T The type of component to pool
+        ///
+        /// \author Miguel Martin
+        template <class T>
+        class StaticComponentPool
+        {
+        public:
+
+            /// The type used to retrieve a component
+            typedef T& Reference;
+
+            /// The type used to retrieve a component of a const pool
+            typedef const T& ConstReference;
+
+            StaticComponentPool() : m_capacity(0) {}
+
+            StaticComponentPool(const StaticComponentPool&) = delete;
+            StaticComponentPool& operator=(const StaticComponentPool&) = delete;
+
+            /// Constructs a component
+            /// \param index The index of the entity
+            /// \param args The arguments for the constructor of the component
+            /// \return The component
+            template <class... Args>
+            T& construct(std::size_t index, Args&&... args)
+            {
+                return *new (&m_components[index]) T{std::forward<Args>(args)...};
+            }
+
+            /// Destroys a component
+            /// \param index The index of the entity
+            void destroy(std::size_t index)
+            {
+                get(index).~T();
+            }
+
+            /// \param index The index of the entity
+            /// \return The component of the entity
+            T& get(std::size_t index)
+            {
+                return *reinterpret_cast<T*>(&m_components[index]);
+            }
+
+            /// \param index The index of the entity
+            /// \return The component of the entity
+            const T& get(std::size_t index) const
+            {
+                return *reinterpret_cast<const T*>(&m_components[index]);
+            }
+
+            /// Resizes the pool, moving the alive components
+            /// \param capacity The amount of entities to store components for
+            /// \param isAlive Determines if the component at an index is alive
+            template <class IsAlive>
+            void resize(std::size_t capacity, IsAlive isAlive)
+            {
+                ANAX_ASSERT(capacity >= m_capacity, "pools of components cannot shrink");
+
+                std::unique_ptr<Storage[], AlignedDeleter> components{static_cast<Storage*>(AllocateAligned(capacity * sizeof(Storage), alignof(T)))};
+                if(std::is_trivially_copyable<T>::value)
+                {
+                    // the components are copied in bulk, which also copies
+                    // the (harmless) bytes of the dead components
+                    if(m_capacity > 0)
+                    {
+                        std::memcpy(components.get(), m_components.get(), m_capacity * sizeof(Storage));
+                    }
+                }
+                else
+                {
+                    for(std::size_t i = 0; i < m_capacity; ++i)
+                    {
+                        if(isAlive(i))
+                        {
+                            new (&components[i]) T(std::move(get(i)));
+                            destroy(i);
+                        }
+                    }
+                }
+
+                m_components = std::move(components);
+                m_capacity = capacity;
+            }
+
+            /// \return The amount of entities the pool can store components for
+            std::size_t getCapacity() const
+            {
+                return m_capacity;
+            }
+
+        private:
+
+            typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+            /// The memory of the components
+            std::unique_ptr<Storage[], AlignedDeleter> m_components;
+
+            /// The amount of entities the pool can store components for
+            std::size_t m_capacity;
+        };
+    }
+}
+
+#endif // ANAX_DETAIL_STATICCOMPONENTPOOL_HPP
@@ -0,0 +1,49 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_UTIL_AABB_HPP
+#define ANAX_UTIL_AABB_HPP
+
+namespace anax
+{
+    namespace util
+    {
+        /// \brief A two dimensional axis aligned bounding box
+        struct Aabb
+        {
+            float minX, minY, maxX, maxY;
+
+            /// \return true if this box overlaps with another box
+            /// \note Boxes that only touch do not overlap
+            bool intersects(const Aabb& box) const
+            {
+                return minX < box.maxX && box.minX < maxX &&
+                       minY < box.maxY && box.minY < maxY;
+            }
+        };
+    }
+}
+
+#endif // ANAX_UTIL_AABB_HPP
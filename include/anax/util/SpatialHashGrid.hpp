@@ -0,0 +1,163 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_UTIL_SPATIALHASHGRID_HPP
+#define ANAX_UTIL_SPATIALHASHGRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <anax/Entity.hpp>
+#include <anax/EntityIdRemap.hpp>
+#include <anax/util/Aabb.hpp>
+
+namespace anax
+{
+    namespace util
+    {
+        /// \brief A uniform grid, used to find entities that are near each other
+        ///
+        /// Entities are inserted with an axis aligned bounding box, and are
+        /// stored within each cell their bounding box overlaps. Cells are
+        /// hashed, thus the grid is unbounded and only occupied cells
+        /// consume memory.
+        ///
+        /// Updating the bounds of an entity is incremental: the entity is
+        /// only moved between cells when the cells it overlaps change.
+        ///
+        /// \author Miguel Martin
+        class SpatialHashGrid
+        {
+        public:
+
+            /// Describes the bounds of an entity
+            using Bounds = Aabb;
+
+            /// Describes a pair of entities whose bounds overlap
+            using EntityPair = std::pair<Entity, Entity>;
+
+            /// \param cellSize The width and height of each cell, this
+            /// should be roughly the size of a typical entity
+            explicit SpatialHashGrid(float cellSize);
+
+            /// Inserts an entity into the grid
+            /// \param entity The entity you wish to insert
+            /// \param bounds The bounds of the entity
+            void insert(const Entity& entity, const Bounds& bounds);
+
+            /// Updates the bounds of an entity within the grid
+            /// \param entity The entity you wish to update
+            /// \param bounds The new bounds of the entity
+            void update(const Entity& entity, const Bounds& bounds);
+
+            /// Removes an entity from the grid
+            /// \param entity The entity you wish to remove
+            void remove(const Entity& entity);
+
+            /// \return true if the entity is within the grid
+            bool contains(const Entity& entity) const;
+
+            /// Moves the entities moved by World::compact to their new
+            /// indices, keeping their bounds
+            /// \param remap The entities that were moved
+            void remap(const EntityIdRemap& remap);
+
+            /// Finds the entities that overlap an area
+            /// \param bounds The area you wish to query
+            /// \param entities The array to append the entities to
+            void query(const Bounds& bounds, std::vector<Entity>& entities) const;
+
+            /// Finds every pair of entities that overlap each other
+            /// \param pairs The array to append the pairs to
+            /// \note Each pair is reported once
+            void queryPairs(std::vector<EntityPair>& pairs) const;
+
+            /// \return The size of each cell
+            float getCellSize() const;
+
+            /// \return The amount of entities within the grid
+            std::size_t getSize() const;
+
+            /// Removes every entity from the grid
+            void clear();
+
+        private:
+
+            typedef std::uint64_t CellKey;
+
+            /// The range of cells a proxy overlaps (inclusive)
+            struct CellRange
+            {
+                int minX, minY, maxX, maxY;
+
+                bool operator==(const CellRange& range) const
+                {
+                    return minX == range.minX && minY == range.minY && maxX == range.maxX && maxY == range.maxY;
+                }
+            };
+
+            /// The representation of an entity within the grid
+            struct Proxy
+            {
+                Proxy() : isInGrid(false) {}
+
+                Entity entity;
+                Bounds bounds;
+                CellRange cells;
+                bool isInGrid;
+            };
+
+            static CellKey MakeKey(int x, int y);
+
+            int getCell(float position) const;
+            CellRange getCellRange(const Bounds& bounds) const;
+
+            void addToCells(std::size_t proxy, const CellRange& range);
+            void removeFromCells(std::size_t proxy, const CellRange& range);
+
+            /// The size of each cell
+            float m_cellSize;
+
+            /// The proxies of the entities, the indices of this array
+            /// is the same as the index component of an entity's ID.
+            std::vector<Proxy> m_proxies;
+
+            /// The occupied cells, each storing the proxies within it
+            std::unordered_map<CellKey, std::vector<std::size_t>> m_cells;
+
+            /// The amount of entities within the grid
+            std::size_t m_size;
+
+            /// Used to avoid reporting a proxy more than once per query
+            mutable std::vector<std::uint32_t> m_queryMarks;
+            mutable std::uint32_t m_queryMark;
+        };
+    }
+}
+
+#endif // ANAX_UTIL_SPATIALHASHGRID_HPP
@@ -0,0 +1,149 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_UTIL_SWEEPANDPRUNE_HPP
+#define ANAX_UTIL_SWEEPANDPRUNE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <anax/Entity.hpp>
+#include <anax/EntityIdRemap.hpp>
+#include <anax/util/Aabb.hpp>
+
+namespace anax
+{
+    namespace util
+    {
+        /// \brief A sort and sweep broadphase, used to find entities that overlap each other
+        ///
+        /// Entities are kept within an array sorted by the start of their
+        /// bounds on the x axis. Finding overlapping pairs is a single sweep
+        /// over this array, where each entity is only tested against the
+        /// entities that start before it ends.
+        ///
+        /// The array is re-sorted with an insertion sort before each sweep,
+        /// as entities rarely move far between updates this is close to
+        /// linear (many insertions at once are sorted from scratch).
+        /// Unlike a SpatialHashGrid, this does not depend on the size
+        /// or the density of the entities.
+        ///
+        /// The bounds are stored as a structure of arrays, which allows the
+        /// sweep to test four candidates at once with SSE (where available).
+        ///
+        /// \author Miguel Martin
+        class SweepAndPrune
+        {
+        public:
+
+            /// Describes the bounds of an entity
+            using Bounds = Aabb;
+
+            /// Describes a pair of entities whose bounds overlap
+            using EntityPair = std::pair<Entity, Entity>;
+
+            SweepAndPrune();
+
+            /// Inserts an entity into the broadphase
+            /// \param entity The entity you wish to insert
+            /// \param bounds The bounds of the entity
+            void insert(const Entity& entity, const Bounds& bounds);
+
+            /// Updates the bounds of an entity within the broadphase
+            /// \param entity The entity you wish to update
+            /// \param bounds The new bounds of the entity
+            void update(const Entity& entity, const Bounds& bounds);
+
+            /// Removes an entity from the broadphase
+            /// \param entity The entity you wish to remove
+            void remove(const Entity& entity);
+
+            /// \return true if the entity is within the broadphase
+            bool contains(const Entity& entity) const;
+
+            /// Moves the entities moved by World::compact to their new
+            /// indices, keeping their bounds
+            /// \param remap The entities that were moved
+            void remap(const EntityIdRemap& remap);
+
+            /// Finds every pair of entities that overlap each other
+            /// \param pairs The array to append the pairs to
+            /// \note Each pair is reported once
+            void queryPairs(std::vector<EntityPair>& pairs);
+
+            /// \return The amount of entities within the broadphase
+            std::size_t getSize() const;
+
+            /// Removes every entity from the broadphase
+            void clear();
+
+        private:
+
+            /// The representation of an entity within the broadphase
+            struct Proxy
+            {
+                Proxy() : position(0), isInSweep(false) {}
+
+                Entity entity;
+
+                /// The position of the proxy within the sorted arrays
+                std::size_t position;
+
+                bool isInSweep;
+            };
+
+            /// Removes the proxies that have been removed from the sorted arrays
+            void compact();
+
+            /// Sorts the arrays by the minimum x of each proxy
+            void sort();
+
+            /// Sorts the arrays from scratch, used after many insertions
+            void sortAll();
+
+            /// The proxies of the entities, the indices of this array
+            /// is the same as the index component of an entity's ID.
+            std::vector<Proxy> m_proxies;
+
+            /// The bounds of the proxies, sorted by m_minX
+            std::vector<float> m_minX;
+            std::vector<float> m_maxX;
+            std::vector<float> m_minY;
+            std::vector<float> m_maxY;
+
+            /// The proxy at each position of the sorted arrays
+            std::vector<std::size_t> m_sorted;
+
+            /// The amount of proxies removed since the last sweep
+            std::size_t m_removedCount;
+
+            /// The amount of proxies inserted since the last sweep
+            std::size_t m_insertedCount;
+        };
+    }
+}
+
+#endif // ANAX_UTIL_SWEEPANDPRUNE_HPP
@@ -0,0 +1,234 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#ifndef ANAX_UTIL_TRACERECORDER_HPP
+#define ANAX_UTIL_TRACERECORDER_HPP
+
+#include <anax/Config.hpp>
+
+#ifdef ANAX_ENABLE_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace anax
+{
+    namespace util
+    {
+        /// \brief Records a timeline of events to a trace event JSON file
+        ///
+        /// The file may be opened with chrome://tracing or Perfetto. Events
+        /// are durations (e.g. a refresh of a World, or an update of a
+        /// system) and counters (e.g. the amount of entities), and may be
+        /// recorded from any thread.
+        ///
+        /// Each thread records events to its own lock-free ring buffer,
+        /// which is drained to the file by a background thread. Recording
+        /// an event never blocks nor allocates memory (other than the first
+        /// event recorded by a thread); if a buffer is full, the event is
+        /// dropped and counted instead.
+        ///
+        /// \note The names of events are not copied, they must outlive the
+        /// recorder (e.g. string literals).
+        ///
+        /// \note This is only available if anax is built with ANAX_ENABLE_TRACING
+        ///
+        /// \author Miguel Martin
+        class TraceRecorder
+        {
+        public:
+
+            /// Describes a point in time
+            typedef std::chrono::steady_clock::time_point TimePoint;
+
+            /// \brief Records a duration event for its lifetime
+            class Scope
+            {
+            public:
+
+                /// \param recorder The recorder to record to, which may be null
+                /// \param name The name of the event
+                /// \param category The category of the event
+                Scope(TraceRecorder* recorder, const char* name, const char* category = DEFAULT_CATEGORY) :
+                    m_recorder(recorder), m_name(name), m_category(category), m_start(recorder ? Now() : TimePoint())
+                {
+                }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+                ~Scope()
+                {
+                    if(m_recorder)
+                        m_recorder->recordDuration(m_name, m_category, m_start, Now());
+                }
+
+            private:
+
+                TraceRecorder* m_recorder;
+                const char* m_name;
+                const char* m_category;
+                TimePoint m_start;
+            };
+
+            /// The category of events, if none is specified
+            static constexpr const char* DEFAULT_CATEGORY = "anax";
+
+            /// The default amount of events that may be buffered per thread
+            static constexpr std::size_t DEFAULT_BUFFER_CAPACITY = 1 << 16;
+
+            /// \param filepath The filepath of the file you wish to write the trace to
+            /// \param bufferCapacity The amount of events that may be buffered per thread,
+            /// this is rounded up to a power of 2
+            explicit TraceRecorder(const std::string& filepath, std::size_t bufferCapacity = DEFAULT_BUFFER_CAPACITY);
+
+            TraceRecorder(const TraceRecorder&) = delete;
+            TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+            /// Writes the remaining events, and closes the file
+            ~TraceRecorder();
+
+            /// \return The current point in time
+            static TimePoint Now() { return std::chrono::steady_clock::now(); }
+
+            /// \return true if the file was opened successfully
+            bool isOpen() const;
+
+            /// Records a duration event
+            /// \param name The name of the event
+            /// \param category The category of the event
+            /// \param start The time the event started
+            /// \param end The time the event ended
+            void recordDuration(const char* name, const char* category, TimePoint start, TimePoint end);
+
+            /// Records a duration event, of which the name is a mangled type name
+            /// (i.e. from std::type_info::name()), which is demangled when it is written
+            /// \param typeName The (mangled) name of the type
+            /// \param category The category of the event
+            /// \param start The time the event started
+            /// \param end The time the event ended
+            void recordTypeDuration(const char* typeName, const char* category, TimePoint start, TimePoint end);
+
+            /// Records the value of a counter
+            /// \param name The name of the counter
+            /// \param value The value of the counter
+            void recordCounter(const char* name, std::int64_t value);
+
+            /// Names the calling thread within the trace
+            /// \param name The name of the thread
+            void setThreadName(const char* name);
+
+            /// \return The amount of events that have been dropped, as buffers were full
+            std::size_t getDroppedEventCount() const;
+
+        private:
+
+            struct Event
+            {
+                enum class Type : std::uint8_t
+                {
+                    Duration,
+                    TypeDuration,
+                    Counter,
+                    ThreadName
+                };
+
+                const char* name;
+                const char* category;
+                std::int64_t timestamp; // ns since the recorder was created
+                std::int64_t value; // duration (ns) or counter value
+                Type type;
+            };
+
+            /// A single producer, single consumer ring buffer of events
+            struct ThreadBuffer
+            {
+                ThreadBuffer(std::size_t capacity, std::uint32_t threadId);
+
+                /// Pushes an event, called by the thread that owns the buffer
+                void push(const Event& event);
+
+                std::unique_ptr<Event[]> events;
+                std::size_t mask;
+                std::uint32_t threadId;
+
+                std::atomic<std::size_t> head;
+                std::atomic<std::size_t> tail;
+                std::atomic<std::size_t> dropped;
+            };
+
+            void record(const Event& event);
+
+            ThreadBuffer& getThreadBuffer();
+
+            /// Writes the events of every buffer to the file
+            void drain();
+
+            void write(const Event& event, std::uint32_t threadId);
+
+            /// \return The demangled name of a type
+            const char* getTypeName(const char* typeName);
+
+            void run();
+
+            /// Identifies the recorder within the buffers of a thread
+            std::uint64_t m_id;
+
+            /// The time the recorder was created, timestamps are relative to this
+            TimePoint m_start;
+
+            std::size_t m_bufferCapacity;
+
+            /// The buffer of each thread that has recorded events
+            std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+            mutable std::mutex m_buffersMutex;
+
+            std::ofstream m_file;
+            bool m_isFirstEvent;
+
+            /// The demangled names of the types that have been traced
+            std::unordered_map<const char*, std::string> m_typeNames;
+
+            /// The background thread, which drains the buffers
+            std::thread m_thread;
+            std::mutex m_threadMutex;
+            std::condition_variable m_threadCondition;
+            bool m_isStopping;
+        };
+    }
+}
+
+#endif // ANAX_ENABLE_TRACING
+
+#endif // ANAX_UTIL_TRACERECORDER_HPP
@@ -0,0 +1,136 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/ComponentRegistry.hpp>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <anax/detail/AnaxAssert.hpp>
+
+namespace anax
+{
+    namespace
+    {
+        /// \brief A component registered with a stable name
+        struct StableComponent
+        {
+            /// The stable name of the component
+            std::string name;
+
+            /// The type ID of the component
+            detail::TypeId typeId;
+        };
+
+        /// \brief Maps the stable keys of components to their type IDs
+        struct StableComponentTable
+        {
+            std::mutex mutex;
+
+            /// The registered components, by their stable keys
+            std::unordered_map<std::uint64_t, StableComponent> components;
+
+            /// The stable key of each type ID, or INVALID_STABLE_COMPONENT_KEY
+            std::vector<std::uint64_t> keys;
+        };
+
+        /// \return The registered components, constructed on first use
+        /// so components may be registered during static initialisation
+        StableComponentTable& GetStableComponentTable()
+        {
+            static StableComponentTable table;
+            return table;
+        }
+    }
+
+    namespace detail
+    {
+        bool MapStableComponentKey(std::uint64_t key, const char* name, TypeId typeId)
+        {
+            auto& table = GetStableComponentTable();
+            std::lock_guard<std::mutex> lock{table.mutex};
+
+            ANAX_ASSERT(key != INVALID_STABLE_COMPONENT_KEY, (std::string{"the stable name \""} + name + "\" has an invalid key").c_str());
+            if(key == INVALID_STABLE_COMPONENT_KEY)
+            {
+                return false;
+            }
+
+            auto it = table.components.find(key);
+            if(it != table.components.end())
+            {
+                auto& registered = it->second;
+                ANAX_ASSERT(registered.name == name, (std::string{"the stable names \""} + registered.name + "\" and \"" + name + "\" have the same key").c_str());
+                ANAX_ASSERT(registered.typeId == typeId, (std::string{"the stable name \""} + name + "\" is registered to another type").c_str());
+
+                // registering a component again is allowed
+                return registered.name == name && registered.typeId == typeId;
+            }
+
+            if(typeId < table.keys.size() && table.keys[typeId] != INVALID_STABLE_COMPONENT_KEY)
+            {
+                ANAX_ASSERT(false, (std::string{"the component registered as \""} + table.components[table.keys[typeId]].name + "\" cannot be registered as \"" + name + "\"").c_str());
+                return false;
+            }
+
+            table.components.emplace(key, StableComponent{name, typeId});
+            if(typeId >= table.keys.size())
+            {
+                table.keys.resize(typeId + 1, INVALID_STABLE_COMPONENT_KEY);
+            }
+            table.keys[typeId] = key;
+            return true;
+        }
+    }
+
+    detail::TypeId GetStableComponentTypeId(std::uint64_t key)
+    {
+        auto& table = GetStableComponentTable();
+        std::lock_guard<std::mutex> lock{table.mutex};
+
+        auto it = table.components.find(key);
+        return it != table.components.end() ? it->second.typeId : detail::INVALID_TYPE_ID;
+    }
+
+    std::uint64_t GetStableComponentKey(detail::TypeId typeId)
+    {
+        auto& table = GetStableComponentTable();
+        std::lock_guard<std::mutex> lock{table.mutex};
+
+        return typeId < table.keys.size() ? table.keys[typeId] : INVALID_STABLE_COMPONENT_KEY;
+    }
+
+    const char* GetStableComponentName(std::uint64_t key)
+    {
+        auto& table = GetStableComponentTable();
+        std::lock_guard<std::mutex> lock{table.mutex};
+
+        // the names are never erased, so the pointer remains valid
+        auto it = table.components.find(key);
+        return it != table.components.end() ? it->second.name.c_str() : nullptr;
+    }
+}
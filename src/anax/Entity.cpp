@@ -30,17 +30,6 @@
 
 namespace anax
 {
-    Entity::Entity() : 
-        m_world(nullptr)
-    {
-    }
-
-    Entity::Entity(World& world, Entity::Id id) : 
-        m_id(id),
-        m_world(&world)
-    {
-    }
-
     World& Entity::getWorld() const
     {
         ANAX_ASSERT(m_world, "world reference in entity is null");
@@ -48,11 +37,6 @@ namespace anax
         return *m_world;
     }
 
-    const Entity::Id& Entity::getId() const
-    {
-        return m_id;
-    }
-
     bool Entity::isValid() const
     {
         //Allows an empty Entity handle to be checked.
@@ -85,6 +69,7 @@ namespace anax
     void Entity::removeAllComponents()
     {
         getWorld().m_entityAttributes.componentStorage.removeAllComponents(*this);
+        getWorld().onComponentsChanged(*this);
     }
 
     ComponentArray Entity::getComponents() const
@@ -102,17 +87,31 @@ namespace anax
         return m_id == entity.m_id && entity.m_world == m_world;
     }
 
-    void Entity::addComponent(Component* component, detail::TypeId componentTypeId)
+    void* Entity::allocateComponent(detail::TypeId componentTypeId, const detail::ComponentTypeInfo& typeInfo)
+    {
+        ANAX_ASSERT(isValid(), "invalid entity cannot have components added to it");
+
+        return getWorld().m_entityAttributes.componentStorage.allocateComponent(componentTypeId, typeInfo);
+    }
+
+    void Entity::deallocateComponent(void* memory, detail::TypeId componentTypeId) const
+    {
+        getWorld().m_entityAttributes.componentStorage.deallocateComponent(memory, componentTypeId);
+    }
+
+    void Entity::addComponent(void* component, detail::TypeId componentTypeId)
     {
         getWorld().m_entityAttributes.componentStorage.addComponent(*this, component, componentTypeId);
+        getWorld().onComponentsChanged(*this);
     }
 
     void Entity::removeComponent(detail::TypeId componentTypeId)
     {
         getWorld().m_entityAttributes.componentStorage.removeComponent(*this, componentTypeId);
+        getWorld().onComponentsChanged(*this);
     }
 
-    Component& Entity::getComponent(detail::TypeId componentTypeId) const
+    void* Entity::getComponent(detail::TypeId componentTypeId) const
     {
         return getWorld().m_entityAttributes.componentStorage.getComponent(*this, componentTypeId);
     }
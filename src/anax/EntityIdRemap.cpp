@@ -0,0 +1,71 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/EntityIdRemap.hpp>
+
+#include <utility>
+
+namespace anax
+{
+    namespace
+    {
+        /// The position of an index that was not moved
+        const std::size_t NOT_MOVED = static_cast<std::size_t>(-1);
+    }
+
+    EntityIdRemap::EntityIdRemap(std::vector<Move> moves) :
+        m_moves(std::move(moves))
+    {
+        for(std::size_t i = 0; i < m_moves.size(); ++i)
+        {
+            auto index = static_cast<std::size_t>(m_moves[i].from.index);
+            if(index >= m_positions.size())
+            {
+                m_positions.resize(index + 1, NOT_MOVED);
+            }
+
+            m_positions[index] = i;
+        }
+    }
+
+    Entity::Id EntityIdRemap::remap(Entity::Id id) const
+    {
+        if(id.index >= m_positions.size() || m_positions[id.index] == NOT_MOVED)
+        {
+            return id;
+        }
+
+        // the ID may refer to an entity that was killed before
+        // the entity at its index was moved
+        auto& move = m_moves[m_positions[id.index]];
+        return move.from == id ? move.to : id;
+    }
+
+    Entity EntityIdRemap::remap(const Entity& entity) const
+    {
+        auto id = remap(entity.getId());
+        return id == entity.getId() ? entity : Entity{entity.getWorld(), id};
+    }
+}
@@ -0,0 +1,65 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/Prefab.hpp>
+
+#include <algorithm>
+
+#include <anax/detail/AnaxAssert.hpp>
+
+namespace anax
+{
+    const detail::ComponentTypeList& Prefab::getComponentTypeList() const
+    {
+        return m_componentTypeList;
+    }
+
+    void Prefab::addComponent(PrototypePtr component, detail::TypeId componentTypeId, const detail::ComponentTypeInfo& typeInfo)
+    {
+        removeComponent(componentTypeId);
+
+        m_prototypes.push_back(Prototype{componentTypeId, &typeInfo, std::move(component)});
+        m_componentTypeList[componentTypeId] = true;
+    }
+
+    void Prefab::removeComponent(detail::TypeId componentTypeId)
+    {
+        m_prototypes.erase(std::remove_if(m_prototypes.begin(), m_prototypes.end(), [&](const Prototype& p) { return p.typeId == componentTypeId; }), m_prototypes.end());
+        m_componentTypeList[componentTypeId] = false;
+    }
+
+    void* Prefab::getComponent(detail::TypeId componentTypeId) const
+    {
+        ANAX_ASSERT(hasComponent(componentTypeId), "Prefab does not contain component");
+
+        auto it = std::find_if(m_prototypes.begin(), m_prototypes.end(), [&](const Prototype& p) { return p.typeId == componentTypeId; });
+        return it->component.get();
+    }
+
+    bool Prefab::hasComponent(detail::TypeId componentTypeId) const
+    {
+        return m_componentTypeList[componentTypeId];
+    }
+}
@@ -30,14 +30,63 @@
 #include <anax/Config.hpp>
 
 #include <anax/detail/AnaxAssert.hpp>
-#include <anax/util/ContainerUtils.hpp>
+
+// statements that collect statistics, which are compiled out if
+// statistics are not enabled
+#ifdef ANAX_ENABLE_STATS
+#   define ANAX_STATS(statement) statement
+#else
+#   define ANAX_STATS(statement)
+#endif // ANAX_ENABLE_STATS
+
+// statements that trace to the recorder of a world, which are
+// compiled out if tracing is not enabled
+#ifdef ANAX_ENABLE_TRACING
+#   define ANAX_TRACE(statement) statement
+#else
+#   define ANAX_TRACE(statement)
+#endif // ANAX_ENABLE_TRACING
 
 namespace anax
 {
+#ifdef ANAX_ENABLE_STATS
+    namespace
+    {
+        typedef std::chrono::steady_clock StatsClock;
+
+        WorldStats::Duration GetElapsedTime(StatsClock::time_point& start)
+        {
+            auto now = StatsClock::now();
+            auto elapsed = std::chrono::duration_cast<WorldStats::Duration>(now - start);
+            start = now;
+            return elapsed;
+        }
+    }
+#endif // ANAX_ENABLE_STATS
+
+#ifdef ANAX_ENABLE_TRACING
+    namespace
+    {
+        void TracePhase(util::TraceRecorder* recorder, const char* name, util::TraceRecorder::TimePoint& start)
+        {
+            if(!recorder)
+                return;
+
+            auto now = util::TraceRecorder::Now();
+            recorder->recordDuration(name, util::TraceRecorder::DEFAULT_CATEGORY, start, now);
+            start = now;
+        }
+    }
+#endif // ANAX_ENABLE_TRACING
+
+
     void World::SystemDeleter::operator() (detail::BaseSystem* system) const
     {
         system->m_world = nullptr;
         system->m_entities.clear();
+        system->m_addedEntities.clear();
+        system->m_removedEntities.clear();
+        ++system->m_entityVersion;
     }
 
     World::World() : 
@@ -46,9 +95,16 @@ namespace anax
     }
 
     World::World(std::size_t entityPoolSize) : 
-        m_entityIdPool(entityPoolSize),
+        World(entityPoolSize, EntityIdLayout{})
+    {
+    }
+
+    World::World(std::size_t entityPoolSize, const EntityIdLayout& idLayout, const EntityIdRecycling& idRecycling) : 
+        m_entityIdPool(entityPoolSize, idLayout, idRecycling),
+        m_hierarchy(*this, entityPoolSize),
         m_entityAttributes(entityPoolSize)
     {
+        ANAX_TRACE(m_traceRecorder = nullptr);
     }
 
     void World::removeAllSystems()
@@ -60,8 +116,9 @@ namespace anax
     {
         checkForResize(1);
 
-        m_entityCache.alive.emplace_back(*this, m_entityIdPool.create());
-        return m_entityCache.alive.back();
+        auto id = m_entityIdPool.create();
+        m_entityCache.alive.emplace_back(id);
+        return Entity{*this, id};
     }
 
     std::vector<Entity> World::createEntities(std::size_t amount)
@@ -81,6 +138,20 @@ namespace anax
         return temp;
     }
 
+    World::EntityArray World::instantiate(const Prefab& prefab, std::size_t amount)
+    {
+        auto entities = createEntities(amount);
+
+        // copy each component type to every entity at once
+        for(auto& prototype : prefab.m_prototypes)
+        {
+            m_entityAttributes.componentStorage.copyComponent(entities, prototype.component.get(), prototype.typeId, *prototype.typeInfo);
+        }
+
+        m_entityCache.activated.insert(m_entityCache.activated.end(), entities.begin(), entities.end());
+        return entities;
+    }
+
     void World::killEntity(Entity& entity)
     {
         // deactivate the entity
@@ -125,46 +196,130 @@ namespace anax
         return m_entityIdPool.isValid(entity.getId());
     }
 
+    bool World::isValid(const EntityHandle& handle) const
+    {
+        return m_entityIdPool.isValid(handle.getId());
+    }
+
+    void World::setParent(const Entity& child, const Entity& parent)
+    {
+        m_hierarchy.setParent(child, parent);
+    }
+
+    void World::removeParent(const Entity& child)
+    {
+        ANAX_ASSERT(isValid(child), "invalid entity cannot have its parent removed");
+
+        m_hierarchy.removeParent(child);
+    }
+
+    Entity World::getParent(const Entity& entity)
+    {
+        ANAX_ASSERT(isValid(entity), "invalid entity cannot retrieve its parent");
+
+        auto parent = m_hierarchy.getParent(entity);
+        return parent.isNull() ? Entity{} : Entity{*this, parent};
+    }
+
+    World::EntityArray World::getChildren(const Entity& entity)
+    {
+        ANAX_ASSERT(isValid(entity), "invalid entity cannot retrieve its children");
+
+        auto& nodes = m_hierarchy.getNodes();
+        auto first = m_hierarchy.getFirstChild(entity);
+        auto count = m_hierarchy.getChildCount(entity);
+
+        EntityArray children;
+        children.reserve(count);
+        for(decltype(count) i = 0; i < count; ++i)
+        {
+            children.push_back(nodes[first + i].entity);
+        }
+
+        return children;
+    }
+
+    const World::HierarchyArray& World::getHierarchy()
+    {
+        return m_hierarchy.getNodes();
+    }
+
     void World::refresh()
     {
+        ANAX_STATS(WorldStats::RefreshStats stats);
+        ANAX_STATS(auto refreshStart = StatsClock::now());
+        ANAX_STATS(auto phaseStart = refreshStart);
+        ANAX_TRACE(auto traceStart = m_traceRecorder ? util::TraceRecorder::Now() : util::TraceRecorder::TimePoint());
+        ANAX_TRACE(auto tracePhaseStart = traceStart);
+
+        // kill the descendants of the killed entities, they
+        // are appended so they are processed within this refresh
+        auto killedCount = m_entityCache.killed.size();
+        for(decltype(killedCount) i = 0; i < killedCount; ++i)
+        {
+            auto entity = m_entityCache.killed[i].resolve(*this);
+            m_hierarchy.getDescendants(entity, m_entityCache.killed);
+        }
+
+        m_entityCache.deactivated.insert(m_entityCache.deactivated.end(), m_entityCache.killed.begin() + killedCount, m_entityCache.killed.end());
+
+        // finding the descendants is part of killing entities
+        ANAX_STATS(stats.killedTime = GetElapsedTime(phaseStart));
+        ANAX_TRACE(TracePhase(m_traceRecorder, "refresh: find descendants", tracePhaseStart));
+
         // go through all the activated entities from last call to refresh
-        for(auto& entity : m_entityCache.activated)
+        for(auto& handle : m_entityCache.activated)
         {
+            auto entity = handle.resolve(*this);
             auto& attribute = m_entityAttributes.attributes[entity.getId().index]; 
             attribute.activated = true;
 
+            auto componentTypeList = m_entityAttributes.componentStorage.getComponentTypeList(entity);
+
             // loop through all the systems within the world
             for(auto& i : m_systems)
             {
                 auto systemIndex = i.first;
 
+                ANAX_STATS(++stats.filterChecks);
+
                 // if the entity passes the filter the system has and is not already part of the system
-                if(i.second->getFilter().doesPassFilter(m_entityAttributes.componentStorage.getComponentTypeList(entity)))
+                if(i.second->getFilter().doesPassFilter(componentTypeList))
                 {
-                    if(attribute.systems.size() <= systemIndex || !attribute.systems[systemIndex])
+                    if(!attribute.systems[systemIndex])
                     {
                         i.second->add(entity); // add it to the system
+                        ANAX_STATS(++stats.systemAdds);
 
-                        util::EnsureCapacity(attribute.systems, systemIndex); 
                         attribute.systems[systemIndex] = true;
                     }
+                    else
+                    {
+                        // the components of the entity may have changed
+                        i.second->reactivate();
+                    }
                 }
                 // otherwise if the entity is within the system 
                 // and is not relevant to the system anymore...
                 // note: the entity has already failed the filter
-                else if(attribute.systems.size() > systemIndex && attribute.systems[systemIndex])
+                else if(attribute.systems[systemIndex])
                 {
                     // duplicate code (1)
                     i.second->remove(entity); 
                     attribute.systems[systemIndex] = false;
+                    ANAX_STATS(++stats.systemRemoves);
                 }
             }
         }
 
+        ANAX_STATS(stats.activatedTime = GetElapsedTime(phaseStart));
+        ANAX_TRACE(TracePhase(m_traceRecorder, "refresh: activated", tracePhaseStart));
+
 
         // go through all the deactivated entities from last call to refresh
-        for(auto& entity : m_entityCache.deactivated)
+        for(auto& handle : m_entityCache.deactivated)
         {
+            auto entity = handle.resolve(*this);
             auto& attribute = m_entityAttributes.attributes[entity.getId().index]; 
             attribute.activated = false;
 
@@ -172,34 +327,131 @@ namespace anax
             for(auto& i : m_systems)
             {
                 auto systemIndex = i.first;
-                if(attribute.systems.size() <= systemIndex) continue;
-
                 if(attribute.systems[systemIndex])
                 {
                     // duplicate code ...(1)
                     i.second->remove(entity); 
                     attribute.systems[systemIndex] = false;
+                    ANAX_STATS(++stats.systemRemoves);
                 }
             }
         }
 
+        // update the entities of the systems, before the
+        // components of the killed entities are destroyed
+        for(auto& i : m_systems)
+        {
+            i.second->applyChanges();
+        }
+
+        ANAX_STATS(stats.deactivatedTime = GetElapsedTime(phaseStart));
+        ANAX_TRACE(TracePhase(m_traceRecorder, "refresh: deactivated", tracePhaseStart));
+
+        // an alive entity is the only entity using its index,
+        // so the killed entities are marked by index
+        auto& isKilled = m_entityCache.isKilled;
+        if(isKilled.size() < m_entityAttributes.attributes.size())
+        {
+            isKilled.resize(m_entityAttributes.attributes.size());
+        }
+
         // go through all the killed entities from last call to refresh
-        for(auto& entity : m_entityCache.killed)
+        for(auto& handle : m_entityCache.killed)
         {
-            // remove the entity from the alive array
-            m_entityCache.alive.erase(std::remove(m_entityCache.alive.begin(), m_entityCache.alive.end(), entity), m_entityCache.alive.end()); 
+            // the entity may have been killed more than once
+            if(!isValid(handle))
+            {
+                continue;
+            }
+
+            auto entity = handle.resolve(*this);
+
+            // remove the entity from the hierarchy
+            m_hierarchy.remove(entity);
+
+            // mark it to be removed from the alive array
+            isKilled[entity.getId().index] = true;
 
             // destroy all the components it has
             m_entityAttributes.componentStorage.removeAllComponents(entity);
 
             // remove it from the id pool
             m_entityIdPool.remove(entity.getId());
+
+            ANAX_STATS(++stats.killedCount);
+        }
+
+        // remove the killed entities from the alive array within one pass
+        if(!m_entityCache.killed.empty())
+        {
+            auto wasKilled = [&isKilled](const EntityHandle& handle)
+            {
+                return isKilled[handle.getId().index];
+            };
+
+            m_entityCache.alive.erase(std::remove_if(m_entityCache.alive.begin(), m_entityCache.alive.end(), wasKilled), m_entityCache.alive.end());
+            std::fill(isKilled.begin(), isKilled.end(), false);
         }
 
+        ANAX_STATS(stats.killedTime += GetElapsedTime(phaseStart));
+        ANAX_STATS(stats.totalTime = GetElapsedTime(refreshStart));
+        ANAX_STATS(stats.activatedCount = m_entityCache.activated.size());
+        ANAX_STATS(stats.deactivatedCount = m_entityCache.deactivated.size());
+        ANAX_STATS(m_stats.lastRefresh = stats);
+        ANAX_STATS(m_stats.totalRefresh += stats);
+        ANAX_STATS(++m_stats.refreshCount);
+
+        ANAX_TRACE(TracePhase(m_traceRecorder, "refresh: killed", tracePhaseStart));
+        ANAX_TRACE(TracePhase(m_traceRecorder, "World::refresh", traceStart));
+        ANAX_TRACE(if(m_traceRecorder) m_traceRecorder->recordCounter("entities", static_cast<std::int64_t>(m_entityCache.alive.size())));
+        ANAX_TRACE(if(m_traceRecorder) m_traceRecorder->recordCounter("activated entities", static_cast<std::int64_t>(m_entityCache.activated.size())));
+        ANAX_TRACE(if(m_traceRecorder) m_traceRecorder->recordCounter("killed entities", static_cast<std::int64_t>(m_entityCache.killed.size())));
+
         // clear the temp cache
         m_entityCache.clearTemp();
     }
 
+    EntityIdRemap World::compact(std::size_t maxMoves)
+    {
+        // only the alive entities are moved
+        refresh();
+
+        EntityIdRemap remap{m_entityIdPool.compact(maxMoves)};
+        if(remap.empty())
+        {
+            return remap;
+        }
+
+        for(auto& move : remap.getMoves())
+        {
+            auto& attributes = m_entityAttributes.attributes;
+            attributes[move.to.index] = attributes[move.from.index];
+            attributes[move.from.index] = EntityAttributes::Attribute{};
+
+            m_entityAttributes.componentStorage.move(move.from, move.to);
+        }
+
+        m_hierarchy.remap(remap);
+
+        for(auto& handle : m_entityCache.alive)
+        {
+            handle = remap.remap(handle);
+        }
+
+        for(auto& system : m_systems)
+        {
+            for(auto& handle : system.second->m_entities)
+            {
+                handle = remap.remap(handle);
+            }
+            ++system.second->m_entityVersion;
+            system.second->sortEntities();
+            system.second->onEntitiesRemapped(remap);
+        }
+
+        return remap;
+    }
+
     void World::clear()
     {
         removeAllSystems(); // remove the systems
@@ -212,6 +464,9 @@ namespace anax
 
         // clear the id pool
         m_entityIdPool.clear();
+
+        // clear the relationships between entities
+        m_hierarchy.clear();
     }
 
     std::size_t World::getEntityCount() const
@@ -219,16 +474,40 @@ namespace anax
         return m_entityCache.alive.size();
     }
 
-    const World::EntityArray& World::getEntities() const
+    EntityRange World::getEntities() const
+    {
+        // entities always refer to a non-const world, as they did
+        // when the world stored them directly
+        return EntityRange{const_cast<World*>(this), m_entityCache.alive};
+    }
+
+    const World::EntityHandleArray& World::getEntityHandles() const
     {
         return m_entityCache.alive;
     }
 
+    const EntityIdLayout& World::getEntityIdLayout() const
+    {
+        return m_entityIdPool.getLayout();
+    }
+
+    const EntityIdRecycling& World::getEntityIdRecycling() const
+    {
+        return m_entityIdPool.getRecycling();
+    }
+
+    std::size_t World::getRetiredEntityIndexCount() const
+    {
+        return m_entityIdPool.getRetiredCount();
+    }
+
     void World::checkForResize(std::size_t amountOfEntitiesToBeAllocated)
     {
-        auto newSize = getEntityCount() + amountOfEntitiesToBeAllocated;
+        auto newSize = m_entityIdPool.getRequiredSize(amountOfEntitiesToBeAllocated);
         if(newSize > m_entityIdPool.getSize())
         {
+            ANAX_ASSERT(newSize <= m_entityIdPool.getLayout().getMaxIndexCount(), "ran out of entity indices, use more index bits");
+
             resize(newSize);
         }
     }
@@ -236,6 +515,7 @@ namespace anax
     void World::resize(std::size_t amount)
     {
         m_entityIdPool.resize(amount);
+        m_hierarchy.resize(amount);
         m_entityAttributes.resize(amount);
     }
 
@@ -243,6 +523,7 @@ namespace anax
     {
         ANAX_ASSERT(!system.m_world, "System is already contained within a World");
         ANAX_ASSERT(m_systems.count(systemTypeId) == 0, "System of this type is already contained within the world");
+        ANAX_ASSERT(systemTypeId < MAX_AMOUNT_OF_SYSTEMS, "Too many types of systems, increase ANAX_MAX_AMOUNT_OF_SYSTEMS");
 
         m_systems[systemTypeId].reset(&system);
 
@@ -256,6 +537,38 @@ namespace anax
         m_systems.erase(systemTypeId);
     }
 
+    void World::onComponentsChanged(const Entity& entity)
+    {
+        onComponentsChanged(m_entityAttributes.attributes[entity.getId().index].systems);
+    }
+
+    void World::onComponentsChanged(const EntityArray& entities)
+    {
+        std::bitset<MAX_AMOUNT_OF_SYSTEMS> systems;
+        for(auto& entity : entities)
+        {
+            systems |= m_entityAttributes.attributes[entity.getId().index].systems;
+        }
+        onComponentsChanged(systems);
+    }
+
+    void World::onComponentsChanged(const std::bitset<MAX_AMOUNT_OF_SYSTEMS>& systems)
+    {
+        // the entity version lets systems know the components they cache may have moved
+        if(systems.none())
+        {
+            return;
+        }
+
+        for(auto& system : m_systems)
+        {
+            if(systems[system.first])
+            {
+                ++system.second->m_entityVersion;
+            }
+        }
+    }
+
     bool World::doesSystemExist(detail::TypeId systemTypeId) const
     {
         return m_systems.find(systemTypeId) != m_systems.end();
@@ -265,4 +578,108 @@ namespace anax
     {
         return Entity{*this, m_entityIdPool.get(index)};
     }
+
+    const WorldStats& World::getStats() const
+    {
+#ifdef ANAX_ENABLE_STATS
+        return m_stats;
+#else
+        // statistics are not collected, so they are always zero
+        static const WorldStats stats;
+        return stats;
+#endif // ANAX_ENABLE_STATS
+    }
+
+    void World::resetStats()
+    {
+        ANAX_STATS(m_stats = WorldStats{});
+    }
+
+    WorldMemoryReport World::getMemoryReport() const
+    {
+        WorldMemoryReport report;
+
+        auto& storage = m_entityAttributes.componentStorage;
+        auto& pools = storage.getComponentPools();
+        for(detail::TypeId typeId = 0; typeId < pools.size(); ++typeId)
+        {
+            auto& pool = pools[typeId];
+            if(!pool)
+                continue;
+
+            WorldMemoryReport::ComponentMemory component;
+            component.typeId = typeId;
+            component.stride = pool->getStride();
+            component.instanceCount = pool->getSize();
+            component.capacity = pool->getCapacity();
+            component.memory = pool->getMemoryUsage();
+            if(component.capacity > 0)
+                component.fragmentation = 1.0 - static_cast<double>(component.instanceCount) / component.capacity;
+
+            report.components.push_back(component);
+        }
+
+        for(auto& pair : m_systems)
+        {
+            WorldMemoryReport::SystemMemory system;
+            system.typeId = pair.first;
+            system.entityCount = pair.second->m_entities.size();
+            system.memory = pair.second->getMemoryUsage();
+            report.systems.push_back(system);
+        }
+
+        report.entityIdPool = m_entityIdPool.getMemoryUsage();
+
+        report.entityAttributes = detail::GetMemoryUsage(m_entityAttributes.attributes);
+
+        report.componentEntries = storage.getMemoryUsage();
+
+        report.entityCache = detail::GetMemoryUsage(m_entityCache.alive);
+        report.entityCache += detail::GetMemoryUsage(m_entityCache.killed);
+        report.entityCache += detail::GetMemoryUsage(m_entityCache.activated);
+        report.entityCache += detail::GetMemoryUsage(m_entityCache.deactivated);
+        report.entityCache += detail::GetMemoryUsage(m_entityCache.isKilled);
+
+        report.hierarchy = m_hierarchy.getMemoryUsage();
+
+        return report;
+    }
+
+#ifdef ANAX_ENABLE_TRACING
+    void World::setTraceRecorder(util::TraceRecorder* recorder)
+    {
+        m_traceRecorder = recorder;
+    }
+
+    util::TraceRecorder* World::getTraceRecorder() const
+    {
+        return m_traceRecorder;
+    }
+#endif // ANAX_ENABLE_TRACING
+
+#if defined(ANAX_ENABLE_STATS) || defined(ANAX_ENABLE_TRACING)
+    void World::onSystemUpdated(const detail::BaseSystem& system, detail::TypeId systemTypeId, const char* systemTypeName,
+                                std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+#ifdef ANAX_ENABLE_STATS
+        auto time = std::chrono::duration_cast<WorldStats::Duration>(end - start);
+
+        auto& stats = m_stats.systems[systemTypeId];
+        stats.lastUpdateTime = time;
+        stats.totalUpdateTime += time;
+        ++stats.updateCount;
+        stats.entityCount = system.getEntities().size();
+#else
+        (void)system;
+        (void)systemTypeId;
+#endif // ANAX_ENABLE_STATS
+
+#ifdef ANAX_ENABLE_TRACING
+        if(m_traceRecorder)
+            m_traceRecorder->recordTypeDuration(systemTypeName, "system", start, end);
+#else
+        (void)systemTypeName;
+#endif // ANAX_ENABLE_TRACING
+    }
+#endif // ANAX_ENABLE_STATS || ANAX_ENABLE_TRACING
 }
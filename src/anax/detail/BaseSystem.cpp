@@ -7,9 +7,20 @@ namespace anax
 {
     namespace detail
     {
+        namespace
+        {
+            bool HasLowerIndex(const EntityHandle& a, const EntityHandle& b)
+            {
+                return a.getId().index < b.getId().index;
+            }
+        }
+
         BaseSystem::BaseSystem(const Filter& filter) : 
             m_world(nullptr),
-            m_filter(filter)
+            m_filter(filter),
+            m_entityOrder(EntityOrder::ACTIVATION),
+            m_hasReactivatedEntities(false),
+            m_entityVersion(0)
         {
         }
 
@@ -28,23 +39,165 @@ namespace anax
             return *m_world;
         }
 
-        const std::vector<Entity>& BaseSystem::getEntities() const
+        EntityRange BaseSystem::getEntities() const
+        {
+            return EntityRange{m_world, m_entities};
+        }
+
+        const std::vector<EntityHandle>& BaseSystem::getEntityHandles() const
         {
             return m_entities;
         }
 
+        void BaseSystem::setEntityOrder(EntityOrder order)
+        {
+            m_entityOrder = order;
+            sortEntities();
+        }
+
+        BaseSystem::EntityOrder BaseSystem::getEntityOrder() const
+        {
+            return m_entityOrder;
+        }
+
+        std::size_t BaseSystem::getEntityVersion() const
+        {
+            return m_entityVersion;
+        }
+
+        MemoryUsage BaseSystem::getMemoryUsage() const
+        {
+            MemoryUsage usage = GetMemoryUsage(m_entities);
+            usage += GetMemoryUsage(m_addedEntities);
+            usage += GetMemoryUsage(m_removedEntities);
+            usage += GetMemoryUsage(m_isRemoved);
+            usage += getCacheMemoryUsage();
+            return usage;
+        }
+
 
         void BaseSystem::add(Entity &entity)
         {
-            m_entities.push_back(entity);
-            onEntityAdded(entity);
+            m_addedEntities.push_back(entity);
         }
 
         void BaseSystem::remove(Entity &entity)
         {
-            m_entities.erase(std::remove(m_entities.begin(), m_entities.end(), entity), m_entities.end());
+            m_removedEntities.push_back(entity);
+        }
+
+        void BaseSystem::reactivate()
+        {
+            m_hasReactivatedEntities = true;
+        }
+
+        void BaseSystem::applyChanges()
+        {
+            if(m_removedEntities.empty() && m_addedEntities.empty() && !m_hasReactivatedEntities)
+            {
+                return;
+            }
+
+            if(!m_removedEntities.empty())
+            {
+                // a system contains at most one entity per index, so the
+                // removed entities are marked by index and removed within
+                // one pass. An entity may also have been added since the
+                // last call.
+                for(auto& handle : m_removedEntities)
+                {
+                    auto index = handle.getId().index;
+                    if(index >= m_isRemoved.size())
+                    {
+                        m_isRemoved.resize(index + 1);
+                    }
+                    m_isRemoved[index] = true;
+                }
+
+                auto isRemoved = [this](const EntityHandle& handle)
+                {
+                    auto index = handle.getId().index;
+                    return index < m_isRemoved.size() && m_isRemoved[index];
+                };
+
+                m_entities.erase(std::remove_if(m_entities.begin(), m_entities.end(), isRemoved), m_entities.end());
+
+                // an entity added and removed since the last call was
+                // never within the system, so neither callback is called
+                auto isNotRemoved = [&isRemoved](const EntityHandle& handle) { return !isRemoved(handle); };
+                auto addedEnd = std::stable_partition(m_addedEntities.begin(), m_addedEntities.end(), isNotRemoved);
+                for(auto i = addedEnd; i != m_addedEntities.end(); ++i)
+                {
+                    m_isRemoved[i->getId().index] = false;
+                }
+                m_addedEntities.erase(addedEnd, m_addedEntities.end());
+            }
+
+            if(m_entityOrder == EntityOrder::ACTIVATION)
+            {
+                m_entities.insert(m_entities.end(), m_addedEntities.begin(), m_addedEntities.end());
+            }
+            else
+            {
+                mergeAddedEntities();
+            }
+
+            m_hasReactivatedEntities = false;
+            ++m_entityVersion;
+
+            // the callbacks are called once the entities of the system
+            // are updated, the removed entities are still valid
+            for(auto& handle : m_removedEntities)
+            {
+                auto index = handle.getId().index;
+                if(m_isRemoved[index])
+                {
+                    m_isRemoved[index] = false;
+
+                    auto entity = handle.resolve(*m_world);
+                    onEntityRemoved(entity);
+                }
+            }
+            m_removedEntities.clear();
+
+            for(auto& handle : m_addedEntities)
+            {
+                auto entity = handle.resolve(*m_world);
+                onEntityAdded(entity);
+            }
+            m_addedEntities.clear();
+        }
+
+        void BaseSystem::mergeAddedEntities()
+        {
+            // merge the added entities from the back, so no
+            // temporary storage is needed (unlike std::inplace_merge)
+            std::sort(m_addedEntities.begin(), m_addedEntities.end(), HasLowerIndex);
+
+            auto entityCount = m_entities.size();
+            auto addedCount = m_addedEntities.size();
+            m_entities.resize(entityCount + addedCount);
 
-            onEntityRemoved(entity);
+            for(auto mergedCount = m_entities.size(); addedCount > 0; )
+            {
+                if(entityCount > 0 && HasLowerIndex(m_addedEntities[addedCount - 1], m_entities[entityCount - 1]))
+                {
+                    m_entities[--mergedCount] = m_entities[--entityCount];
+                }
+                else
+                {
+                    m_entities[--mergedCount] = m_addedEntities[--addedCount];
+                }
+            }
+        }
+
+        void BaseSystem::sortEntities()
+        {
+            if(m_entityOrder == EntityOrder::INDEX)
+            {
+                std::sort(m_entities.begin(), m_entities.end(), HasLowerIndex);
+                ++m_entityVersion;
+            }
         }
 
         void BaseSystem::setWorld(World &world)
@@ -0,0 +1,129 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/detail/ComponentPool.hpp>
+
+#include <algorithm>
+
+#include <anax/detail/AnaxAssert.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        /// The minimum amount of components allocated within a chunk
+        static const std::size_t MIN_CHUNK_CAPACITY = 32;
+
+        ComponentPool::ComponentPool(const ComponentTypeInfo& typeInfo) :
+            m_typeInfo(&typeInfo),
+            m_stride((typeInfo.size + typeInfo.alignment - 1) / typeInfo.alignment * typeInfo.alignment),
+            m_capacity(0)
+        {
+        }
+
+        void* ComponentPool::allocate()
+        {
+            if(m_freeList.empty())
+            {
+                // grow geometrically, so the amount of chunks stays small
+                addChunk(std::max(MIN_CHUNK_CAPACITY, m_capacity));
+            }
+
+            void* memory = m_freeList.back();
+            m_freeList.pop_back();
+            return memory;
+        }
+
+        void ComponentPool::destroy(void* component)
+        {
+            if(!m_typeInfo->isTriviallyDestructible)
+            {
+                m_typeInfo->destroy(component);
+            }
+            m_freeList.push_back(component);
+        }
+
+        void ComponentPool::deallocate(void* memory)
+        {
+            m_freeList.push_back(memory);
+        }
+
+        void ComponentPool::reserve(std::size_t amount)
+        {
+            if(m_freeList.size() < amount)
+            {
+                addChunk(std::max(MIN_CHUNK_CAPACITY, amount - m_freeList.size()));
+            }
+        }
+
+        const ComponentTypeInfo& ComponentPool::getTypeInfo() const
+        {
+            return *m_typeInfo;
+        }
+
+        std::size_t ComponentPool::getSize() const
+        {
+            return m_capacity - m_freeList.size();
+        }
+
+        std::size_t ComponentPool::getCapacity() const
+        {
+            return m_capacity;
+        }
+
+        std::size_t ComponentPool::getStride() const
+        {
+            return m_stride;
+        }
+
+        MemoryUsage ComponentPool::getMemoryUsage() const
+        {
+            MemoryUsage usage(getSize() * m_stride, m_capacity * m_stride);
+            usage += GetMemoryUsage(m_chunks);
+            usage += GetMemoryUsage(m_freeList);
+            return usage;
+        }
+
+        void ComponentPool::addChunk(std::size_t capacity)
+        {
+            Chunk chunk;
+            chunk.memory.reset(static_cast<char*>(AllocateAligned(capacity * m_stride, m_typeInfo->alignment)));
+            chunk.capacity = capacity;
+
+            // add the memory in reverse, so that components
+            // are allocated in order of their address. The free list
+            // is reserved so it can hold every component of the pool,
+            // thus destroying a component never allocates.
+            m_freeList.reserve(m_capacity + capacity);
+            for(std::size_t i = capacity; i > 0; --i)
+            {
+                m_freeList.push_back(chunk.memory.get() + (i - 1) * m_stride);
+            }
+
+            m_chunks.push_back(std::move(chunk));
+            m_capacity += capacity;
+        }
+    }
+}
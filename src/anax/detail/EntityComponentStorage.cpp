@@ -25,6 +25,8 @@
 
 #include <anax/detail/EntityComponentStorage.hpp>
 
+#include <cstring>
+
 #include <anax/util/ContainerUtils.hpp>
 #include <anax/detail/AnaxAssert.hpp>
 
@@ -37,17 +39,81 @@ namespace anax
         {
         }
 
-        void EntityComponentStorage::addComponent(Entity& entity, Component* component, TypeId componentTypeId)
+        EntityComponentStorage::~EntityComponentStorage()
+        {
+            clear();
+        }
+
+        void* EntityComponentStorage::allocateComponent(TypeId componentTypeId, const ComponentTypeInfo& typeInfo)
+        {
+            return getComponentPool(componentTypeId, typeInfo).allocate();
+        }
+
+        void EntityComponentStorage::deallocateComponent(void* memory, TypeId componentTypeId)
+        {
+            m_componentPools[componentTypeId]->deallocate(memory);
+        }
+
+        void EntityComponentStorage::addComponent(Entity& entity, void* component, TypeId componentTypeId)
         {
             ANAX_ASSERT(entity.isValid(), "invalid entity cannot have components added to it");
 
-            auto index = entity.getId().index;
-            auto& componentDataForEntity = m_componentEntries[index];
+            setComponent(entity, component, componentTypeId);
+        }
 
-            componentDataForEntity.components[componentTypeId].reset(component);
+        ComponentPool& EntityComponentStorage::reserveComponents(const std::vector<Entity>& entities, TypeId componentTypeId, const ComponentTypeInfo& typeInfo)
+        {
+#if ANAX_ASSERTS_ENABLED
+            // every entity is validated before any is modified
+            for(auto& entity : entities)
+            {
+                ANAX_ASSERT(entity.isValid(), "invalid entity cannot have components added to it");
+            }
+#endif
+
+            auto& pool = getComponentPool(componentTypeId, typeInfo);
+            pool.reserve(entities.size());
+            return pool;
+        }
+
+        void EntityComponentStorage::setComponent(const Entity& entity, void* component, TypeId componentTypeId)
+        {
+            auto& componentDataForEntity = m_componentEntries[entity.getId().index];
+
+            // destroy the component being replaced (if any)
+            auto& slot = componentDataForEntity.components[componentTypeId];
+            if(slot)
+            {
+                m_componentPools[componentTypeId]->destroy(slot);
+            }
+
+            slot = component;
             componentDataForEntity.componentTypeList[componentTypeId] = true;
         }
 
+        void EntityComponentStorage::copyComponent(const std::vector<Entity>& entities, const void* component, TypeId componentTypeId, const ComponentTypeInfo& typeInfo)
+        {
+            ANAX_ASSERT(typeInfo.copy != nullptr, "component cannot be copied");
+
+            auto& pool = reserveComponents(entities, componentTypeId, typeInfo);
+
+            for(auto& entity : entities)
+            {
+                void* memory = pool.allocate();
+
+                if(typeInfo.isTriviallyCopyable)
+                {
+                    std::memcpy(memory, component, typeInfo.size);
+                }
+                else
+                {
+                    typeInfo.copy(memory, component);
+                }
+
+                setComponent(entity, memory, componentTypeId);
+            }
+        }
+
         void EntityComponentStorage::removeComponent(Entity& entity, TypeId componentTypeId)
         {
             ANAX_ASSERT(entity.isValid(), "invalid entity cannot remove components");
@@ -55,24 +121,68 @@ namespace anax
             auto index = entity.getId().index;
             auto& componentDataForEntity = m_componentEntries[index];
 
-            componentDataForEntity.components[componentTypeId].reset();
+            auto& slot = componentDataForEntity.components[componentTypeId];
+            if(slot)
+            {
+                m_componentPools[componentTypeId]->destroy(slot);
+                slot = nullptr;
+            }
             componentDataForEntity.componentTypeList[componentTypeId] = false;
         }
 
+        void EntityComponentStorage::removeComponents(const std::vector<Entity>& entities, TypeId componentTypeId)
+        {
+#if ANAX_ASSERTS_ENABLED
+            // every entity is validated before any is modified
+            for(auto& entity : entities)
+            {
+                ANAX_ASSERT(entity.isValid(), "invalid entity cannot remove components");
+            }
+#endif
+
+            if(m_componentPools.size() <= componentTypeId || !m_componentPools[componentTypeId])
+            {
+                // no entity has ever had this type of component
+                return;
+            }
+
+            auto& pool = *m_componentPools[componentTypeId];
+            for(auto& entity : entities)
+            {
+                auto& componentDataForEntity = m_componentEntries[entity.getId().index];
+
+                auto& slot = componentDataForEntity.components[componentTypeId];
+                if(slot)
+                {
+                    pool.destroy(slot);
+                    slot = nullptr;
+                }
+                componentDataForEntity.componentTypeList[componentTypeId] = false;
+            }
+        }
+
         void EntityComponentStorage::removeAllComponents(Entity &entity)
         {
             auto index = entity.getId().index;
             auto& componentDataForEntity = m_componentEntries[index];
 
-            for(auto& c : componentDataForEntity.components) c.reset();
+            for(std::size_t i = 0; i < componentDataForEntity.components.size(); ++i)
+            {
+                auto& slot = componentDataForEntity.components[i];
+                if(slot)
+                {
+                    m_componentPools[i]->destroy(slot);
+                    slot = nullptr;
+                }
+            }
             componentDataForEntity.componentTypeList.reset();
         }
 
-        Component& EntityComponentStorage::getComponent(const Entity& entity, TypeId componentTypeId) const
+        void* EntityComponentStorage::getComponent(const Entity& entity, TypeId componentTypeId) const
         {
             ANAX_ASSERT(entity.isValid() && hasComponent(entity, componentTypeId), "Entity is not valid or does not contain component");
 
-            return *getComponentsImpl(entity)[componentTypeId];
+            return getComponentsImpl(entity)[componentTypeId];
         }
 
         ComponentTypeList EntityComponentStorage::getComponentTypeList(const Entity& entity) const
@@ -91,8 +201,11 @@ namespace anax
             ComponentArray temp;
             temp.reserve(componentsToConvert.size());
 
-            for(auto& i : componentsToConvert)
-                temp.emplace_back(i.get());
+            for(std::size_t i = 0; i < componentsToConvert.size(); ++i)
+            {
+                auto component = componentsToConvert[i];
+                temp.emplace_back(component ? m_componentPools[i]->getTypeInfo().toComponent(component) : nullptr);
+            }
 
             return temp;
         }
@@ -106,6 +219,24 @@ namespace anax
             return components.size() > componentTypeId && components[componentTypeId] != nullptr;
         }
 
+        const std::vector<std::unique_ptr<ComponentPool>>& EntityComponentStorage::getComponentPools() const
+        {
+            return m_componentPools;
+        }
+
+        MemoryUsage EntityComponentStorage::getMemoryUsage() const
+        {
+            MemoryUsage usage = GetMemoryUsage(m_componentEntries);
+            usage += GetMemoryUsage(m_componentPools);
+            return usage;
+        }
+
+        void EntityComponentStorage::move(Entity::Id from, Entity::Id to)
+        {
+            m_componentEntries[to.index] = m_componentEntries[from.index];
+            m_componentEntries[from.index] = EntityComponents{};
+        }
+
         void EntityComponentStorage::resize(std::size_t entityAmount)
         {
             m_componentEntries.resize(entityAmount);
@@ -113,9 +244,40 @@ namespace anax
 
         void EntityComponentStorage::clear()
         {
+            // destroy every component that is still alive
+            for(auto& componentDataForEntity : m_componentEntries)
+            {
+                if(componentDataForEntity.componentTypeList.none())
+                {
+                    continue;
+                }
+
+                for(std::size_t i = 0; i < componentDataForEntity.components.size(); ++i)
+                {
+                    auto component = componentDataForEntity.components[i];
+                    if(component)
+                    {
+                        m_componentPools[i]->destroy(component);
+                    }
+                }
+            }
+
             m_componentEntries.clear();
         }
 
+        ComponentPool& EntityComponentStorage::getComponentPool(TypeId componentTypeId, const ComponentTypeInfo& typeInfo)
+        {
+            util::EnsureCapacity(m_componentPools, componentTypeId);
+
+            auto& pool = m_componentPools[componentTypeId];
+            if(!pool)
+            {
+                pool.reset(new ComponentPool(typeInfo));
+            }
+
+            return *pool;
+        }
+
         EntityComponentStorage::ImplComponentArray& EntityComponentStorage::getComponentsImpl(const Entity &e)
         {
             return m_componentEntries[e.getId().index].components;
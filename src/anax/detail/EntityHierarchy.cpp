@@ -0,0 +1,261 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/detail/EntityHierarchy.hpp>
+
+#include <anax/detail/AnaxAssert.hpp>
+
+namespace anax
+{
+    namespace detail
+    {
+        const std::size_t EntityHierarchy::NO_PARENT = static_cast<std::size_t>(-1);
+
+        EntityHierarchy::EntityHierarchy(World& world, std::size_t entityAmount) :
+            m_world(&world),
+            m_relations(entityAmount),
+            m_isDirty(false)
+        {
+        }
+
+        void EntityHierarchy::setParent(const Entity& child, const Entity& parent)
+        {
+            ANAX_ASSERT(child.isValid() && parent.isValid(), "invalid entity cannot be part of a hierarchy");
+            ANAX_ASSERT(child != parent, "an entity cannot be its own parent");
+
+            // make sure the child is not an ancestor of the parent
+            for(auto ancestor = parent.getId(); !ancestor.isNull(); ancestor = m_relations[ancestor.index].parent)
+            {
+                ANAX_ASSERT(ancestor != child.getId(), "an entity cannot be the parent of its ancestor");
+            }
+
+            removeParent(child);
+
+            auto& childRelation = m_relations[child.getId().index];
+            auto& parentRelation = m_relations[parent.getId().index];
+
+            childRelation.id = child.getId();
+            childRelation.parent = parent.getId();
+
+            parentRelation.id = parent.getId();
+            ++parentRelation.childCount;
+
+            m_isDirty = true;
+        }
+
+        void EntityHierarchy::removeParent(const Entity& child)
+        {
+            auto& relation = m_relations[child.getId().index];
+            if(relation.parent.isNull())
+            {
+                return;
+            }
+
+            --m_relations[relation.parent.index].childCount;
+            relation.parent.clear();
+
+            m_isDirty = true;
+        }
+
+        Entity::Id EntityHierarchy::getParent(const Entity& entity) const
+        {
+            return m_relations[entity.getId().index].parent;
+        }
+
+        std::size_t EntityHierarchy::getChildCount(const Entity& entity) const
+        {
+            return m_relations[entity.getId().index].childCount;
+        }
+
+        std::size_t EntityHierarchy::getFirstChild(const Entity& entity)
+        {
+            if(m_isDirty)
+            {
+                rebuild();
+            }
+
+            return m_relations[entity.getId().index].firstChild;
+        }
+
+        const std::vector<EntityHierarchy::Node>& EntityHierarchy::getNodes()
+        {
+            if(m_isDirty)
+            {
+                rebuild();
+            }
+
+            return m_nodes;
+        }
+
+        void EntityHierarchy::getDescendants(const Entity& entity, std::vector<EntityHandle>& descendants)
+        {
+            if(getChildCount(entity) == 0)
+            {
+                return;
+            }
+
+            auto& nodes = getNodes();
+
+            // use the output as a queue, as the children
+            // of every entity are contiguous within the nodes
+            auto begin = descendants.size();
+            auto index = entity.getId().index;
+            do
+            {
+                auto& relation = m_relations[index];
+                for(std::size_t i = 0; i < relation.childCount; ++i)
+                {
+                    descendants.push_back(nodes[relation.firstChild + i].entity);
+                }
+                
+                if(begin == descendants.size())
+                {
+                    break;
+                }
+
+                index = descendants[begin++].getId().index;
+            }
+            while(true);
+        }
+
+        void EntityHierarchy::remove(const Entity& entity)
+        {
+            auto& relation = m_relations[entity.getId().index];
+            if(relation.id.isNull())
+            {
+                // the entity was never part of the hierarchy
+                return;
+            }
+
+            removeParent(entity);
+            relation.id.clear();
+
+            m_isDirty = true;
+        }
+
+        MemoryUsage EntityHierarchy::getMemoryUsage() const
+        {
+            MemoryUsage usage = GetMemoryUsage(m_relations);
+            usage += GetMemoryUsage(m_nodes);
+            usage += GetMemoryUsage(m_children);
+            return usage;
+        }
+
+        void EntityHierarchy::remap(const EntityIdRemap& remap)
+        {
+            bool isPartOfHierarchy = false;
+            for(auto& move : remap.getMoves())
+            {
+                auto& relation = m_relations[move.to.index];
+                relation = m_relations[move.from.index];
+                m_relations[move.from.index] = Relation{};
+
+                if(!relation.id.isNull())
+                {
+                    relation.id = move.to;
+                    isPartOfHierarchy = true;
+                }
+            }
+
+            if(!isPartOfHierarchy)
+            {
+                return;
+            }
+
+            for(auto& relation : m_relations)
+            {
+                if(!relation.parent.isNull())
+                {
+                    relation.parent = remap.remap(relation.parent);
+                }
+            }
+
+            // the nodes refer to the old IDs
+            m_isDirty = true;
+        }
+
+        void EntityHierarchy::resize(std::size_t entityAmount)
+        {
+            m_relations.resize(entityAmount);
+        }
+
+        void EntityHierarchy::clear()
+        {
+            m_relations.clear();
+            m_nodes.clear();
+            m_children.clear();
+            m_isDirty = false;
+        }
+
+        void EntityHierarchy::rebuild()
+        {
+            // group the children by their parent
+            std::size_t offset = 0;
+            for(auto& relation : m_relations)
+            {
+                relation.firstChild = offset;
+                offset += relation.childCount;
+            }
+
+            m_children.resize(offset);
+            for(auto& relation : m_relations)
+            {
+                if(!relation.parent.isNull())
+                {
+                    m_children[m_relations[relation.parent.index].firstChild++] = relation.id;
+                }
+            }
+
+            for(auto& relation : m_relations)
+            {
+                relation.firstChild -= relation.childCount;
+            }
+
+            // flatten the hierarchy breadth first, starting with the roots
+            m_nodes.clear();
+            for(auto& relation : m_relations)
+            {
+                if(relation.parent.isNull() && relation.childCount > 0)
+                {
+                    m_nodes.push_back(Node{Entity{*m_world, relation.id}, NO_PARENT});
+                }
+            }
+
+            for(std::size_t position = 0; position < m_nodes.size(); ++position)
+            {
+                auto& relation = m_relations[m_nodes[position].entity.getId().index];
+                auto begin = relation.firstChild;
+
+                relation.firstChild = m_nodes.size();
+                for(std::size_t i = 0; i < relation.childCount; ++i)
+                {
+                    m_nodes.push_back(Node{Entity{*m_world, m_children[begin + i]}, position});
+                }
+            }
+
+            m_isDirty = false;
+        }
+    }
+}
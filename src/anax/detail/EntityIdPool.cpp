@@ -27,15 +27,38 @@
 
 #include <anax/detail/AnaxAssert.hpp>
 
+#include <algorithm>
+
 namespace anax
 {
     namespace detail
     {
-        EntityIdPool::EntityIdPool(std::size_t poolSize) : 
+        namespace
+        {
+            /// Orders the free list as a heap with the lowest index on top
+            bool HasHigherIndex(const Entity::Id& a, const Entity::Id& b)
+            {
+                return a.index > b.index;
+            }
+
+            bool HasLowerIndex(const Entity::Id& a, const Entity::Id& b)
+            {
+                return a.index < b.index;
+            }
+        }
+
+        EntityIdPool::EntityIdPool(std::size_t poolSize, const EntityIdLayout& layout, const EntityIdRecycling& recycling) : 
             m_defaultPoolSize(poolSize),
+            m_layout(layout),
+            m_retiredCount(0),
+            m_recycling(recycling),
             m_nextId(0),
+            m_freeListBegin(0),
+            m_quarantineBegin(0),
             m_counts(poolSize)
         {
+            ANAX_ASSERT(layout.isValid(), "entity ID layout does not fit within the bits of an ID");
+            ANAX_ASSERT(poolSize <= layout.getMaxIndexCount(), "entity pool is larger than the amount of indices of the layout");
         }
 
         Entity::Id EntityIdPool::create()
@@ -43,13 +66,14 @@ namespace anax
             Entity::Id id;
 
             // if we need to add more entities to the pool
-            if(!m_freeList.empty())
+            if(getFreeCount() > 0)
             {
-                id = m_freeList.back();
-                m_freeList.pop_back();
+                id = popFreeId();
             }
             else
             {
+                ANAX_ASSERT(m_nextId < m_layout.getMaxIndexCount(), "ran out of entity indices, use more index bits");
+
                 id.index = m_nextId++;
                 // an ID given out cannot have a counter of 0. 
                 // 0 is an "invalid" counter, thus we must update
@@ -63,16 +87,46 @@ namespace anax
         void EntityIdPool::remove(Entity::Id id)
         {
             auto& counter = m_counts[id.index];
+
+            // retire the index rather than wrap its counter, otherwise
+            // old IDs with the same index would become valid again
+            if(counter >= m_layout.getMaxCounter())
+            {
+                counter = 0;
+                ++m_retiredCount;
+                return;
+            }
+
             ++counter; // increment the counter in the cache
-            m_freeList.emplace_back(static_cast<Entity::Id::int_type>(id.index), counter); // add the ID to the freeList
+            Entity::Id freeId{static_cast<Entity::Id::int_type>(id.index), counter};
+
+            // hold the ID aside, and release the oldest ID of the
+            // quarantine to the free list once it is full
+            if(m_recycling.quarantineCount > 0)
+            {
+                m_quarantine.push_back(freeId);
+                if(m_quarantine.size() - m_quarantineBegin <= m_recycling.quarantineCount)
+                {
+                    return;
+                }
+
+                freeId = m_quarantine[m_quarantineBegin++];
+                if(m_quarantineBegin * 2 >= m_quarantine.size())
+                {
+                    m_quarantine.erase(m_quarantine.begin(), m_quarantine.begin() + m_quarantineBegin);
+                    m_quarantineBegin = 0;
+                }
+            }
+
+            pushFreeId(freeId);
         }
 
         Entity::Id EntityIdPool::get(std::size_t index) const
         {
             if(index < m_counts.size())
-                return Entity::Id{index, m_counts[index]};
+                return Entity::Id{static_cast<Entity::Id::int_type>(index), m_counts[index]};
             else
-                return Entity::Id{index, 0};
+                return Entity::Id{static_cast<Entity::Id::int_type>(index), 0};
         }
 
         bool EntityIdPool::isValid(Entity::Id id) const
@@ -88,16 +142,168 @@ namespace anax
             return m_counts.size(); 
         }
 
+        std::vector<EntityIdRemap::Move> EntityIdPool::compact(std::size_t maxMoves)
+        {
+            std::vector<EntityIdRemap::Move> moves;
+
+            m_freeList.erase(m_freeList.begin(), m_freeList.begin() + m_freeListBegin);
+            m_freeListBegin = 0;
+            std::sort(m_freeList.begin(), m_freeList.end(), HasLowerIndex);
+
+            std::vector<bool> isFree(m_nextId, false);
+            for(auto& id : m_freeList)
+            {
+                isFree[id.index] = true;
+            }
+
+            // quarantined indices are not alive, but are not moved to
+            for(auto i = m_quarantineBegin; i < m_quarantine.size(); ++i)
+            {
+                isFree[m_quarantine[i].index] = true;
+            }
+
+            // move the highest alive index to the lowest free index,
+            // until every free index is above every alive index;
+            // retired indices are neither alive nor free
+            std::size_t freePosition = 0;
+            std::size_t end = m_nextId;
+            while(moves.size() < maxMoves && freePosition < m_freeList.size())
+            {
+                while(end > 0 && (isFree[end - 1] || m_counts[end - 1] == 0))
+                {
+                    --end;
+                }
+
+                auto to = m_freeList[freePosition];
+                if(end == 0 || to.index >= end - 1)
+                {
+                    break;
+                }
+
+                --end;
+                moves.push_back(EntityIdRemap::Move{Entity::Id{static_cast<Entity::Id::int_type>(end), m_counts[end]}, to});
+                ++freePosition;
+            }
+
+            m_freeList.erase(m_freeList.begin(), m_freeList.begin() + freePosition);
+            for(auto& move : moves)
+            {
+                remove(move.from);
+            }
+
+            sortFreeList();
+            return moves;
+        }
+
+        std::size_t EntityIdPool::getRequiredSize(std::size_t amount) const
+        {
+            // quarantined IDs are not within the free list
+            return static_cast<std::size_t>(m_nextId) + amount - std::min(amount, getFreeCount());
+        }
+
+        std::size_t EntityIdPool::getRetiredCount() const
+        {
+            return m_retiredCount;
+        }
+
+        const EntityIdLayout& EntityIdPool::getLayout() const
+        {
+            return m_layout;
+        }
+
+        const EntityIdRecycling& EntityIdPool::getRecycling() const
+        {
+            return m_recycling;
+        }
+
+        MemoryUsage EntityIdPool::getMemoryUsage() const
+        {
+            MemoryUsage usage = GetMemoryUsage(m_counts);
+            usage += GetMemoryUsage(m_freeList);
+            usage += GetMemoryUsage(m_quarantine);
+            return usage;
+        }
+
         void EntityIdPool::resize(std::size_t amount)
         {
             m_counts.resize(amount);
         }
 
+        std::size_t EntityIdPool::getFreeCount() const
+        {
+            return m_freeList.size() - m_freeListBegin;
+        }
+
+        void EntityIdPool::pushFreeId(Entity::Id id)
+        {
+            m_freeList.push_back(id);
+
+            if(m_recycling.order == EntityIdRecyclingOrder::LOWEST_INDEX_FIRST)
+            {
+                std::push_heap(m_freeList.begin(), m_freeList.end(), HasHigherIndex);
+            }
+        }
+
+        Entity::Id EntityIdPool::popFreeId()
+        {
+            Entity::Id id;
+
+            switch(m_recycling.order)
+            {
+                case EntityIdRecyclingOrder::LIFO:
+                    id = m_freeList.back();
+                    m_freeList.pop_back();
+                    break;
+
+                case EntityIdRecyclingOrder::FIFO:
+                    id = m_freeList[m_freeListBegin++];
+
+                    // drop the used front of the queue, once it is
+                    // at least half of the free list
+                    if(m_freeListBegin * 2 >= m_freeList.size())
+                    {
+                        m_freeList.erase(m_freeList.begin(), m_freeList.begin() + m_freeListBegin);
+                        m_freeListBegin = 0;
+                    }
+                    break;
+
+                case EntityIdRecyclingOrder::LOWEST_INDEX_FIRST:
+                    std::pop_heap(m_freeList.begin(), m_freeList.end(), HasHigherIndex);
+                    id = m_freeList.back();
+                    m_freeList.pop_back();
+                    break;
+            }
+
+            return id;
+        }
+
+        void EntityIdPool::sortFreeList()
+        {
+            switch(m_recycling.order)
+            {
+                case EntityIdRecyclingOrder::LIFO:
+                    std::sort(m_freeList.begin() + m_freeListBegin, m_freeList.end(), HasHigherIndex);
+                    break;
+
+                case EntityIdRecyclingOrder::FIFO:
+                    std::sort(m_freeList.begin() + m_freeListBegin, m_freeList.end(), HasLowerIndex);
+                    break;
+
+                case EntityIdRecyclingOrder::LOWEST_INDEX_FIRST:
+                    std::make_heap(m_freeList.begin() + m_freeListBegin, m_freeList.end(), HasHigherIndex);
+                    break;
+            }
+        }
+
         void EntityIdPool::clear()
         {
             m_counts.clear();
             m_freeList.clear();
+            m_freeListBegin = 0;
+            m_quarantine.clear();
+            m_quarantineBegin = 0;
             m_nextId = 0;
+            m_retiredCount = 0;
         }
     }
 }
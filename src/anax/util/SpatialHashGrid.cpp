@@ -0,0 +1,266 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/util/SpatialHashGrid.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <anax/detail/AnaxAssert.hpp>
+#include <anax/util/ContainerUtils.hpp>
+
+namespace anax
+{
+    namespace util
+    {
+        SpatialHashGrid::SpatialHashGrid(float cellSize) :
+            m_cellSize(cellSize),
+            m_size(0),
+            m_queryMark(0)
+        {
+            ANAX_ASSERT(cellSize > 0, "cell size of a grid must be positive");
+        }
+
+        void SpatialHashGrid::insert(const Entity& entity, const Bounds& bounds)
+        {
+            auto index = entity.getId().index;
+            EnsureCapacity(m_proxies, index);
+
+            auto& proxy = m_proxies[index];
+            ANAX_ASSERT(!proxy.isInGrid, "entity is already within the grid");
+
+            proxy.entity = entity;
+            proxy.bounds = bounds;
+            proxy.cells = getCellRange(bounds);
+            proxy.isInGrid = true;
+
+            addToCells(index, proxy.cells);
+            ++m_size;
+        }
+
+        void SpatialHashGrid::update(const Entity& entity, const Bounds& bounds)
+        {
+            ANAX_ASSERT(contains(entity), "entity is not within the grid");
+
+            auto index = entity.getId().index;
+            auto& proxy = m_proxies[index];
+            proxy.bounds = bounds;
+
+            auto cells = getCellRange(bounds);
+            if(cells == proxy.cells)
+            {
+                return;
+            }
+
+            removeFromCells(index, proxy.cells);
+            addToCells(index, cells);
+            proxy.cells = cells;
+        }
+
+        void SpatialHashGrid::remove(const Entity& entity)
+        {
+            ANAX_ASSERT(contains(entity), "entity is not within the grid");
+
+            auto index = entity.getId().index;
+            auto& proxy = m_proxies[index];
+
+            removeFromCells(index, proxy.cells);
+            proxy.isInGrid = false;
+            --m_size;
+        }
+
+        bool SpatialHashGrid::contains(const Entity& entity) const
+        {
+            auto index = entity.getId().index;
+            return index < m_proxies.size() && m_proxies[index].isInGrid && m_proxies[index].entity == entity;
+        }
+
+        void SpatialHashGrid::remap(const EntityIdRemap& remap)
+        {
+            for(auto& move : remap.getMoves())
+            {
+                auto from = static_cast<std::size_t>(move.from.index);
+                if(from >= m_proxies.size() || !m_proxies[from].isInGrid || m_proxies[from].entity.getId() != move.from)
+                {
+                    continue;
+                }
+
+                auto proxy = m_proxies[from];
+                removeFromCells(from, proxy.cells);
+                m_proxies[from].isInGrid = false;
+
+                auto to = static_cast<std::size_t>(move.to.index);
+                EnsureCapacity(m_proxies, to);
+                proxy.entity = remap.remap(proxy.entity);
+                m_proxies[to] = proxy;
+                addToCells(to, proxy.cells);
+            }
+        }
+
+        void SpatialHashGrid::query(const Bounds& bounds, std::vector<Entity>& entities) const
+        {
+            m_queryMarks.resize(m_proxies.size());
+            if(++m_queryMark == 0)
+            {
+                // the marks have wrapped around, reset them
+                std::fill(m_queryMarks.begin(), m_queryMarks.end(), 0);
+                m_queryMark = 1;
+            }
+
+            auto range = getCellRange(bounds);
+            for(int x = range.minX; x <= range.maxX; ++x)
+            {
+                for(int y = range.minY; y <= range.maxY; ++y)
+                {
+                    auto cell = m_cells.find(MakeKey(x, y));
+                    if(cell == m_cells.end())
+                    {
+                        continue;
+                    }
+
+                    for(auto index : cell->second)
+                    {
+                        if(m_queryMarks[index] == m_queryMark)
+                        {
+                            continue;
+                        }
+
+                        m_queryMarks[index] = m_queryMark;
+
+                        auto& proxy = m_proxies[index];
+                        if(proxy.bounds.intersects(bounds))
+                        {
+                            entities.push_back(proxy.entity);
+                        }
+                    }
+                }
+            }
+        }
+
+        void SpatialHashGrid::queryPairs(std::vector<EntityPair>& pairs) const
+        {
+            for(auto& cell : m_cells)
+            {
+                auto& indices = cell.second;
+                if(indices.size() < 2)
+                {
+                    continue;
+                }
+
+                auto cellX = static_cast<int>(static_cast<std::uint32_t>(cell.first >> 32));
+                auto cellY = static_cast<int>(static_cast<std::uint32_t>(cell.first));
+
+                for(std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    auto& a = m_proxies[indices[i]];
+                    for(std::size_t j = i + 1; j < indices.size(); ++j)
+                    {
+                        auto& b = m_proxies[indices[j]];
+                        if(!a.bounds.intersects(b.bounds))
+                        {
+                            continue;
+                        }
+
+                        // a pair may share many cells; only report it within
+                        // the cell that contains the corner of their overlap
+                        if(getCell(std::max(a.bounds.minX, b.bounds.minX)) != cellX ||
+                           getCell(std::max(a.bounds.minY, b.bounds.minY)) != cellY)
+                        {
+                            continue;
+                        }
+
+                        pairs.emplace_back(a.entity, b.entity);
+                    }
+                }
+            }
+        }
+
+        float SpatialHashGrid::getCellSize() const
+        {
+            return m_cellSize;
+        }
+
+        std::size_t SpatialHashGrid::getSize() const
+        {
+            return m_size;
+        }
+
+        void SpatialHashGrid::clear()
+        {
+            m_proxies.clear();
+            m_cells.clear();
+            m_queryMarks.clear();
+            m_size = 0;
+        }
+
+        SpatialHashGrid::CellKey SpatialHashGrid::MakeKey(int x, int y)
+        {
+            return (static_cast<CellKey>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+        }
+
+        int SpatialHashGrid::getCell(float position) const
+        {
+            return static_cast<int>(std::floor(position / m_cellSize));
+        }
+
+        SpatialHashGrid::CellRange SpatialHashGrid::getCellRange(const Bounds& bounds) const
+        {
+            return CellRange{getCell(bounds.minX), getCell(bounds.minY), getCell(bounds.maxX), getCell(bounds.maxY)};
+        }
+
+        void SpatialHashGrid::addToCells(std::size_t proxy, const CellRange& range)
+        {
+            for(int x = range.minX; x <= range.maxX; ++x)
+            {
+                for(int y = range.minY; y <= range.maxY; ++y)
+                {
+                    m_cells[MakeKey(x, y)].push_back(proxy);
+                }
+            }
+        }
+
+        void SpatialHashGrid::removeFromCells(std::size_t proxy, const CellRange& range)
+        {
+            for(int x = range.minX; x <= range.maxX; ++x)
+            {
+                for(int y = range.minY; y <= range.maxY; ++y)
+                {
+                    auto cell = m_cells.find(MakeKey(x, y));
+                    ANAX_ASSERT(cell != m_cells.end(), "proxy is not within the cell");
+
+                    auto& indices = cell->second;
+                    auto it = std::find(indices.begin(), indices.end(), proxy);
+                    *it = indices.back();
+                    indices.pop_back();
+
+                    if(indices.empty())
+                    {
+                        m_cells.erase(cell);
+                    }
+                }
+            }
+        }
+    }
+}
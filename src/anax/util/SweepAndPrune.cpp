@@ -0,0 +1,326 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/util/SweepAndPrune.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+#include <anax/detail/AnaxAssert.hpp>
+#include <anax/util/ContainerUtils.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ANAX_SWEEP_AND_PRUNE_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace anax
+{
+    namespace util
+    {
+        namespace
+        {
+            /// Marks a position within the sorted arrays which has been removed
+            const std::size_t REMOVED_PROXY = static_cast<std::size_t>(-1);
+
+            /// The amount of insertions between sweeps, after which the
+            /// arrays are sorted from scratch rather than incrementally
+            const std::size_t MAX_INCREMENTAL_INSERTIONS = 64;
+
+            template <typename T>
+            void Reorder(std::vector<T>& values, const std::vector<std::size_t>& order, std::vector<T>& buffer)
+            {
+                buffer.resize(values.size());
+                for(std::size_t i = 0; i < order.size(); ++i)
+                {
+                    buffer[i] = values[order[i]];
+                }
+                values.swap(buffer);
+            }
+        }
+
+        SweepAndPrune::SweepAndPrune() :
+            m_removedCount(0),
+            m_insertedCount(0)
+        {
+        }
+
+        void SweepAndPrune::insert(const Entity& entity, const Bounds& bounds)
+        {
+            auto index = entity.getId().index;
+            EnsureCapacity(m_proxies, index);
+
+            auto& proxy = m_proxies[index];
+            ANAX_ASSERT(!proxy.isInSweep, "entity is already within the broadphase");
+
+            proxy.entity = entity;
+            proxy.position = m_sorted.size();
+            proxy.isInSweep = true;
+
+            // the proxy is moved to its sorted position before the next sweep
+            m_minX.push_back(bounds.minX);
+            m_maxX.push_back(bounds.maxX);
+            m_minY.push_back(bounds.minY);
+            m_maxY.push_back(bounds.maxY);
+            m_sorted.push_back(index);
+            ++m_insertedCount;
+        }
+
+        void SweepAndPrune::update(const Entity& entity, const Bounds& bounds)
+        {
+            ANAX_ASSERT(contains(entity), "entity is not within the broadphase");
+
+            auto position = m_proxies[entity.getId().index].position;
+            m_minX[position] = bounds.minX;
+            m_maxX[position] = bounds.maxX;
+            m_minY[position] = bounds.minY;
+            m_maxY[position] = bounds.maxY;
+        }
+
+        void SweepAndPrune::remove(const Entity& entity)
+        {
+            ANAX_ASSERT(contains(entity), "entity is not within the broadphase");
+
+            auto& proxy = m_proxies[entity.getId().index];
+            proxy.isInSweep = false;
+
+            // the sorted arrays are compacted before the next sweep, so that
+            // removing many entities at once is not quadratic
+            m_sorted[proxy.position] = REMOVED_PROXY;
+            ++m_removedCount;
+        }
+
+        bool SweepAndPrune::contains(const Entity& entity) const
+        {
+            auto index = entity.getId().index;
+            return index < m_proxies.size() && m_proxies[index].isInSweep && m_proxies[index].entity == entity;
+        }
+
+        void SweepAndPrune::remap(const EntityIdRemap& remap)
+        {
+            for(auto& move : remap.getMoves())
+            {
+                auto from = static_cast<std::size_t>(move.from.index);
+                if(from >= m_proxies.size() || !m_proxies[from].isInSweep || m_proxies[from].entity.getId() != move.from)
+                {
+                    continue;
+                }
+
+                // the bounds stay at the same position of the sorted arrays
+                auto proxy = m_proxies[from];
+                m_proxies[from].isInSweep = false;
+
+                auto to = static_cast<std::size_t>(move.to.index);
+                EnsureCapacity(m_proxies, to);
+                proxy.entity = remap.remap(proxy.entity);
+                m_proxies[to] = proxy;
+                m_sorted[proxy.position] = to;
+            }
+        }
+
+        void SweepAndPrune::queryPairs(std::vector<EntityPair>& pairs)
+        {
+            compact();
+            sort();
+
+            auto size = m_sorted.size();
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                auto minX = m_minX[i];
+                auto maxX = m_maxX[i];
+                auto minY = m_minY[i];
+                auto maxY = m_maxY[i];
+                auto& entity = m_proxies[m_sorted[i]].entity;
+
+                // every proxy after i starts after it on the x axis, thus
+                // the sweep stops at the first proxy that starts after i ends
+                std::size_t j = i + 1;
+
+#ifdef ANAX_SWEEP_AND_PRUNE_SSE2
+                auto minX4 = _mm_set1_ps(minX);
+                auto maxX4 = _mm_set1_ps(maxX);
+                auto minY4 = _mm_set1_ps(minY);
+                auto maxY4 = _mm_set1_ps(maxY);
+
+                for(; j + 4 <= size; j += 4)
+                {
+                    auto startsBeforeEnd = _mm_cmplt_ps(_mm_loadu_ps(&m_minX[j]), maxX4);
+                    auto startsBeforeEndMask = _mm_movemask_ps(startsBeforeEnd);
+                    if(startsBeforeEndMask == 0)
+                    {
+                        break;
+                    }
+
+                    // a candidate starting at the same x must also end after i starts
+                    auto overlapsX = _mm_and_ps(startsBeforeEnd, _mm_cmplt_ps(minX4, _mm_loadu_ps(&m_maxX[j])));
+                    auto overlapsY = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_minY[j]), maxY4),
+                                                _mm_cmplt_ps(minY4, _mm_loadu_ps(&m_maxY[j])));
+
+                    auto overlaps = _mm_movemask_ps(_mm_and_ps(overlapsX, overlapsY));
+                    for(int k = 0; overlaps != 0; ++k, overlaps >>= 1)
+                    {
+                        if(overlaps & 1)
+                        {
+                            pairs.emplace_back(entity, m_proxies[m_sorted[j + k]].entity);
+                        }
+                    }
+
+                    // the rest of this batch starts after i ends
+                    if(startsBeforeEndMask != 0xF)
+                    {
+                        j = size;
+                        break;
+                    }
+                }
+#endif // ANAX_SWEEP_AND_PRUNE_SSE2
+
+                for(; j < size && m_minX[j] < maxX; ++j)
+                {
+                    // a candidate starting at the same x must also end after i starts
+                    if(minX < m_maxX[j] && m_minY[j] < maxY && minY < m_maxY[j])
+                    {
+                        pairs.emplace_back(entity, m_proxies[m_sorted[j]].entity);
+                    }
+                }
+            }
+        }
+
+        std::size_t SweepAndPrune::getSize() const
+        {
+            return m_sorted.size() - m_removedCount;
+        }
+
+        void SweepAndPrune::clear()
+        {
+            m_proxies.clear();
+            m_minX.clear();
+            m_maxX.clear();
+            m_minY.clear();
+            m_maxY.clear();
+            m_sorted.clear();
+            m_removedCount = 0;
+            m_insertedCount = 0;
+        }
+
+        void SweepAndPrune::compact()
+        {
+            if(m_removedCount == 0)
+            {
+                return;
+            }
+
+            std::size_t size = 0;
+            for(std::size_t i = 0; i < m_sorted.size(); ++i)
+            {
+                if(m_sorted[i] == REMOVED_PROXY)
+                {
+                    continue;
+                }
+
+                m_minX[size] = m_minX[i];
+                m_maxX[size] = m_maxX[i];
+                m_minY[size] = m_minY[i];
+                m_maxY[size] = m_maxY[i];
+                m_sorted[size] = m_sorted[i];
+                m_proxies[m_sorted[size]].position = size;
+                ++size;
+            }
+
+            m_minX.resize(size);
+            m_maxX.resize(size);
+            m_minY.resize(size);
+            m_maxY.resize(size);
+            m_sorted.resize(size);
+            m_removedCount = 0;
+        }
+
+        void SweepAndPrune::sort()
+        {
+            if(m_insertedCount > MAX_INCREMENTAL_INSERTIONS)
+            {
+                sortAll();
+                return;
+            }
+
+            // an insertion sort, as the order rarely changes between sweeps
+            for(std::size_t i = 1; i < m_sorted.size(); ++i)
+            {
+                auto minX = m_minX[i];
+                if(!(minX < m_minX[i - 1]))
+                {
+                    continue;
+                }
+
+                auto maxX = m_maxX[i];
+                auto minY = m_minY[i];
+                auto maxY = m_maxY[i];
+                auto proxy = m_sorted[i];
+
+                auto j = i;
+                for(; j > 0 && minX < m_minX[j - 1]; --j)
+                {
+                    m_minX[j] = m_minX[j - 1];
+                    m_maxX[j] = m_maxX[j - 1];
+                    m_minY[j] = m_minY[j - 1];
+                    m_maxY[j] = m_maxY[j - 1];
+                    m_sorted[j] = m_sorted[j - 1];
+                    m_proxies[m_sorted[j]].position = j;
+                }
+
+                m_minX[j] = minX;
+                m_maxX[j] = maxX;
+                m_minY[j] = minY;
+                m_maxY[j] = maxY;
+                m_sorted[j] = proxy;
+                m_proxies[proxy].position = j;
+            }
+
+            m_insertedCount = 0;
+        }
+
+        void SweepAndPrune::sortAll()
+        {
+            std::vector<std::size_t> order(m_sorted.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return m_minX[a] < m_minX[b]; });
+
+            std::vector<float> buffer;
+            Reorder(m_minX, order, buffer);
+            Reorder(m_maxX, order, buffer);
+            Reorder(m_minY, order, buffer);
+            Reorder(m_maxY, order, buffer);
+
+            std::vector<std::size_t> sorted;
+            Reorder(m_sorted, order, sorted);
+
+            for(std::size_t i = 0; i < m_sorted.size(); ++i)
+            {
+                m_proxies[m_sorted[i]].position = i;
+            }
+
+            m_insertedCount = 0;
+        }
+    }
+}
@@ -0,0 +1,294 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <anax/util/TraceRecorder.hpp>
+
+#ifdef ANAX_ENABLE_TRACING
+
+#include <cstdlib>
+#include <iomanip>
+#include <utility>
+
+#ifdef __GNUG__
+#   include <cxxabi.h>
+#endif // __GNUG__
+
+namespace anax
+{
+    namespace util
+    {
+        namespace
+        {
+            /// The interval at which the buffers are drained
+            const std::chrono::milliseconds DRAIN_INTERVAL{50};
+
+            std::atomic<std::uint64_t> NextRecorderId{1};
+
+            std::size_t RoundUpToPowerOf2(std::size_t value)
+            {
+                std::size_t result = 1;
+                while(result < value)
+                    result <<= 1;
+                return result;
+            }
+
+            void WriteEscaped(std::ostream& stream, const char* str)
+            {
+                for(; *str; ++str)
+                {
+                    auto c = *str;
+                    if(c == '"' || c == '\\')
+                        stream << '\\' << c;
+                    else if(static_cast<unsigned char>(c) < 0x20)
+                        stream << ' ';
+                    else
+                        stream << c;
+                }
+            }
+
+            std::string Demangle(const char* typeName)
+            {
+                std::string name = typeName;
+#ifdef __GNUG__
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(typeName, nullptr, nullptr, &status);
+                if(status == 0 && demangled)
+                    name = demangled;
+                std::free(demangled);
+#endif // __GNUG__
+                return name;
+            }
+        }
+
+        constexpr const char* TraceRecorder::DEFAULT_CATEGORY;
+        constexpr std::size_t TraceRecorder::DEFAULT_BUFFER_CAPACITY;
+
+        TraceRecorder::ThreadBuffer::ThreadBuffer(std::size_t capacity, std::uint32_t threadId) :
+            events(new Event[capacity]),
+            mask(capacity - 1),
+            threadId(threadId),
+            head(0),
+            tail(0),
+            dropped(0)
+        {
+        }
+
+        void TraceRecorder::ThreadBuffer::push(const Event& event)
+        {
+            auto currentHead = head.load(std::memory_order_relaxed);
+            if(currentHead - tail.load(std::memory_order_acquire) > mask)
+            {
+                // the buffer is full, dropping the event rather
+                // than waiting keeps the cost of tracing constant
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            events[currentHead & mask] = event;
+            head.store(currentHead + 1, std::memory_order_release);
+        }
+
+        TraceRecorder::TraceRecorder(const std::string& filepath, std::size_t bufferCapacity) :
+            m_id(NextRecorderId++),
+            m_start(Now()),
+            m_bufferCapacity(RoundUpToPowerOf2(bufferCapacity < 2 ? 2 : bufferCapacity)),
+            m_file(filepath),
+            m_isFirstEvent(true),
+            m_isStopping(false)
+        {
+            m_file << std::fixed << std::setprecision(3);
+            m_file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            m_thread = std::thread(&TraceRecorder::run, this);
+        }
+
+        TraceRecorder::~TraceRecorder()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_threadMutex);
+                m_isStopping = true;
+            }
+
+            m_threadCondition.notify_one();
+            m_thread.join();
+
+            drain();
+            m_file << "\n]}\n";
+        }
+
+        bool TraceRecorder::isOpen() const
+        {
+            return m_file.is_open();
+        }
+
+        void TraceRecorder::recordDuration(const char* name, const char* category, TimePoint start, TimePoint end)
+        {
+            record(Event{name, category,
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_start).count(),
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                         Event::Type::Duration});
+        }
+
+        void TraceRecorder::recordTypeDuration(const char* typeName, const char* category, TimePoint start, TimePoint end)
+        {
+            record(Event{typeName, category,
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_start).count(),
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                         Event::Type::TypeDuration});
+        }
+
+        void TraceRecorder::recordCounter(const char* name, std::int64_t value)
+        {
+            record(Event{name, DEFAULT_CATEGORY,
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - m_start).count(),
+                         value,
+                         Event::Type::Counter});
+        }
+
+        void TraceRecorder::setThreadName(const char* name)
+        {
+            record(Event{name, DEFAULT_CATEGORY, 0, 0, Event::Type::ThreadName});
+        }
+
+        std::size_t TraceRecorder::getDroppedEventCount() const
+        {
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+            std::size_t dropped = 0;
+            for(auto& buffer : m_buffers)
+                dropped += buffer->dropped.load(std::memory_order_relaxed);
+            return dropped;
+        }
+
+        void TraceRecorder::record(const Event& event)
+        {
+            getThreadBuffer().push(event);
+        }
+
+        TraceRecorder::ThreadBuffer& TraceRecorder::getThreadBuffer()
+        {
+            // the buffers of this thread, for each recorder it has recorded to
+            thread_local std::vector<std::pair<std::uint64_t, ThreadBuffer*>> buffers;
+
+            for(auto& buffer : buffers)
+            {
+                if(buffer.first == m_id)
+                    return *buffer.second;
+            }
+
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+            auto threadId = static_cast<std::uint32_t>(m_buffers.size() + 1);
+            m_buffers.emplace_back(new ThreadBuffer(m_bufferCapacity, threadId));
+            buffers.emplace_back(m_id, m_buffers.back().get());
+            return *m_buffers.back();
+        }
+
+        void TraceRecorder::drain()
+        {
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+            for(auto& buffer : m_buffers)
+            {
+                auto tail = buffer->tail.load(std::memory_order_relaxed);
+                auto head = buffer->head.load(std::memory_order_acquire);
+
+                for(; tail != head; ++tail)
+                {
+                    write(buffer->events[tail & buffer->mask], buffer->threadId);
+                }
+
+                buffer->tail.store(tail, std::memory_order_release);
+            }
+
+            m_file.flush();
+        }
+
+        void TraceRecorder::write(const Event& event, std::uint32_t threadId)
+        {
+            if(!m_isFirstEvent)
+                m_file << ",\n";
+            m_isFirstEvent = false;
+
+            auto name = event.name;
+            if(event.type == Event::Type::TypeDuration)
+            {
+                name = getTypeName(event.name);
+            }
+            else if(event.type == Event::Type::ThreadName)
+            {
+                name = "thread_name";
+            }
+
+            m_file << "{\"name\":\"";
+            WriteEscaped(m_file, name);
+            m_file << "\",\"pid\":1,\"tid\":" << threadId;
+
+            switch(event.type)
+            {
+                case Event::Type::Duration:
+                case Event::Type::TypeDuration:
+                    m_file << ",\"cat\":\"";
+                    WriteEscaped(m_file, event.category);
+                    m_file << "\",\"ph\":\"X\",\"ts\":" << event.timestamp / 1000.0 << ",\"dur\":" << event.value / 1000.0 << '}';
+                    break;
+                case Event::Type::Counter:
+                    m_file << ",\"ph\":\"C\",\"ts\":" << event.timestamp / 1000.0 << ",\"args\":{\"value\":" << event.value << "}}";
+                    break;
+                case Event::Type::ThreadName:
+                    m_file << ",\"ph\":\"M\",\"args\":{\"name\":\"";
+                    WriteEscaped(m_file, event.name);
+                    m_file << "\"}}";
+                    break;
+            }
+        }
+
+        const char* TraceRecorder::getTypeName(const char* typeName)
+        {
+            // types are traced repeatedly, so their names are only demangled once
+            auto it = m_typeNames.find(typeName);
+            if(it == m_typeNames.end())
+            {
+                it = m_typeNames.emplace(typeName, Demangle(typeName)).first;
+            }
+
+            return it->second.c_str();
+        }
+
+        void TraceRecorder::run()
+        {
+            std::unique_lock<std::mutex> lock(m_threadMutex);
+            while(!m_isStopping)
+            {
+                m_threadCondition.wait_for(lock, DRAIN_INTERVAL);
+
+                lock.unlock();
+                drain();
+                lock.lock();
+            }
+        }
+    }
+}
+
+#endif // ANAX_ENABLE_TRACING
@@ -29,6 +29,7 @@
 #include <stdexcept>
 
 #include <anax/System.hpp>
+#include <anax/CachedSystem.hpp>
 
 #include "Components.hpp"
 
@@ -61,6 +62,24 @@ private:
     }
 };
 
+class CachedMovementSystem : public anax::CachedSystem<anax::Requires<PositionComponent, VelocityComponent>>
+{
+public:
+
+    void update()
+    {
+        for(auto& tuple : getComponentTuples())
+        {
+            auto& position = *std::get<1>(tuple);
+            auto& velocity = *std::get<2>(tuple);
+
+            position.x += velocity.x;
+            position.y += velocity.y;
+            position.z += velocity.z;
+        }
+    }
+};
+
 class PlayerSystem : public anax::System<anax::Requires<PlayerComponent>, anax::Excludes<NPCComponent>>
 {
 private:
@@ -0,0 +1,219 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <cstdlib>
+#include <new>
+
+#include <anax/anax.hpp>
+using namespace anax;
+
+#include "Systems.hpp"
+
+// Every allocation of this test is counted, by replacing the global
+// operator new, so that the steady state of a world can be checked to
+// not allocate.
+//
+// Here are the possible test cases we need to test for:
+//
+// 1. Steady state of a world (after the world has warmed up)
+//      ✓ Killing, creating and activating entities, then refreshing => no allocations?
+//      ✓ Killing entities with children => no allocations?
+//      ✓ Updating systems => no allocations?
+//      ✓ Keeping the entities of a system sorted by index => no allocations?
+
+namespace
+{
+    bool g_countAllocations = false;
+    std::size_t g_allocationCount = 0;
+
+    /// Counts the allocations made while it is alive
+    class AllocationCounter
+    {
+    public:
+
+        AllocationCounter()
+        {
+            g_allocationCount = 0;
+            g_countAllocations = true;
+        }
+
+        ~AllocationCounter()
+        {
+            g_countAllocations = false;
+        }
+
+        std::size_t getCount() const
+        {
+            return g_allocationCount;
+        }
+    };
+
+    const std::size_t ENTITY_AMOUNT = 1000;
+    const std::size_t RESPAWNS_PER_TICK = 50;
+    const std::size_t WARM_UP_TICKS = 50;
+    const std::size_t MEASURED_TICKS = 100;
+
+    Entity spawn(World& world, std::size_t i)
+    {
+        auto entity = world.createEntity();
+        entity.addComponent<PositionComponent>();
+        entity.addComponent<VelocityComponent>().x = 1;
+        if(i % 10 == 0)
+        {
+            entity.addComponent<PlayerComponent>();
+        }
+        entity.activate();
+        return entity;
+    }
+
+    /// Replaces a few entities (some of them with a child), refreshes
+    /// the world and updates its systems
+    void tick(World& world, MovementSystem& movementSystem, World::EntityArray& entities, std::size_t tickNumber)
+    {
+        for(std::size_t i = 0; i < RESPAWNS_PER_TICK; ++i)
+        {
+            auto index = (tickNumber * RESPAWNS_PER_TICK * 7 + i * 13) % entities.size();
+            auto& entity = entities[index];
+            entity.kill();
+
+            entity = spawn(world, i);
+            if(i % 5 == 0)
+            {
+                // the child is killed along with its parent
+                world.setParent(spawn(world, i), entity);
+            }
+        }
+
+        world.refresh();
+        movementSystem.update();
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Steady state refreshes and updates do not allocate")
+    {
+        World world;
+        MovementSystem movementSystem;
+        PlayerSystem playerSystem;
+        world.addSystem(movementSystem);
+        world.addSystem(playerSystem);
+
+        World::EntityArray entities;
+        for(std::size_t i = 0; i < ENTITY_AMOUNT; ++i)
+        {
+            entities.push_back(spawn(world, i));
+        }
+        world.refresh();
+
+        std::size_t tickNumber = 0;
+        for(; tickNumber < WARM_UP_TICKS; ++tickNumber)
+        {
+            tick(world, movementSystem, entities, tickNumber);
+        }
+
+        auto entityCount = world.getEntityCount();
+
+        AllocationCounter allocations;
+        for(; tickNumber < WARM_UP_TICKS + MEASURED_TICKS; ++tickNumber)
+        {
+            tick(world, movementSystem, entities, tickNumber);
+        }
+
+        EXPECT(allocations.getCount() == 0);
+        EXPECT(world.getEntityCount() == entityCount);
+        EXPECT(movementSystem.getEntities().size() == entityCount);
+    },
+
+    CASE("Steady state refreshes and updates do not allocate with entities sorted by index")
+    {
+        World world;
+        MovementSystem movementSystem;
+        PlayerSystem playerSystem;
+        movementSystem.setEntityOrder(MovementSystem::EntityOrder::INDEX);
+        world.addSystem(movementSystem);
+        world.addSystem(playerSystem);
+
+        World::EntityArray entities;
+        for(std::size_t i = 0; i < ENTITY_AMOUNT; ++i)
+        {
+            entities.push_back(spawn(world, i));
+        }
+        world.refresh();
+
+        std::size_t tickNumber = 0;
+        for(; tickNumber < WARM_UP_TICKS; ++tickNumber)
+        {
+            tick(world, movementSystem, entities, tickNumber);
+        }
+
+        auto entityCount = world.getEntityCount();
+
+        AllocationCounter allocations;
+        for(; tickNumber < WARM_UP_TICKS + MEASURED_TICKS; ++tickNumber)
+        {
+            tick(world, movementSystem, entities, tickNumber);
+        }
+
+        EXPECT(allocations.getCount() == 0);
+        EXPECT(world.getEntityCount() == entityCount);
+        EXPECT(movementSystem.getEntities().size() == entityCount);
+    },
+
+    CASE("Allocations are counted")
+    {
+        AllocationCounter allocations;
+        std::unique_ptr<int> allocated{new int{0}};
+        EXPECT(allocations.getCount() == 1);
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
+
+void* operator new(std::size_t size)
+{
+    if(g_countAllocations)
+    {
+        ++g_allocationCount;
+    }
+
+    void* memory = std::malloc(size != 0 ? size : 1);
+    if(!memory)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
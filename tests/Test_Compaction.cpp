@@ -0,0 +1,317 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <anax/World.hpp>
+#include <anax/util/SpatialHashGrid.hpp>
+#include <anax/util/SweepAndPrune.hpp>
+using namespace anax;
+
+#include "Components.hpp"
+#include "Systems.hpp"
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Compacting a world
+//      ✓ Are the alive entities within a dense range of indices?
+//      ✓ Are the components of moved entities kept?
+//      ✓ Are the entities of systems remapped?
+//      ✓ Are the entities of systems kept by index still sorted?
+//      ✓ Are the old IDs of moved entities invalidated, and remapped?
+//      ✓ Are the parents and children of moved entities kept?
+//      ✓ Are killed entities that were not refreshed removed first?
+//      ✓ Are systems that keep entities by index told of the moves?
+// 2. Compacting a world incrementally
+//      ✓ Are at most the maximum amount of entities moved?
+//      ✓ Is a dense world left unchanged?
+
+namespace
+{
+    /// Creates entities with a position of their number
+    std::vector<Entity> createEntities(World& world, MovementSystem& movementSystem, std::size_t amount)
+    {
+        world.addSystem(movementSystem);
+
+        std::vector<Entity> entities;
+        for(std::size_t i = 0; i < amount; ++i)
+        {
+            auto entity = world.createEntity();
+            entity.addComponent<PositionComponent>().x = static_cast<float>(i);
+            entity.addComponent<VelocityComponent>();
+            entity.activate();
+            entities.push_back(entity);
+        }
+        world.refresh();
+
+        return entities;
+    }
+
+    /// Keeps its entities within broadphases, which store them by index
+    struct BroadphaseSystem : System<Requires<PositionComponent>>
+    {
+        util::SpatialHashGrid grid{1};
+        util::SweepAndPrune sweepAndPrune;
+
+        /// \return Bounds that overlap the entities with the next position
+        static util::Aabb getBounds(const Entity& entity)
+        {
+            auto x = entity.getComponent<PositionComponent>().x;
+            return util::Aabb{x, 0, x + 1.5f, 1};
+        }
+
+        void update()
+        {
+            for(auto& entity : getEntities())
+            {
+                grid.update(entity, getBounds(entity));
+                sweepAndPrune.update(entity, getBounds(entity));
+            }
+        }
+
+    private:
+
+        virtual void onEntityAdded(Entity& entity) override
+        {
+            grid.insert(entity, getBounds(entity));
+            sweepAndPrune.insert(entity, getBounds(entity));
+        }
+
+        virtual void onEntityRemoved(Entity& entity) override
+        {
+            grid.remove(entity);
+            sweepAndPrune.remove(entity);
+        }
+
+        virtual void onEntitiesRemapped(const EntityIdRemap& remap) override
+        {
+            grid.remap(remap);
+            sweepAndPrune.remap(remap);
+        }
+    };
+
+    std::size_t getHighestIndex(World& world)
+    {
+        std::size_t highest = 0;
+        for(auto& handle : world.getEntityHandles())
+        {
+            highest = std::max<std::size_t>(highest, handle.getId().index);
+        }
+        return highest;
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Compacting a world")
+    {
+        World world;
+        MovementSystem movementSystem;
+        auto entities = createEntities(world, movementSystem, 10);
+
+        for(auto i : { 0, 2, 3, 5 })
+        {
+            entities[i].kill();
+        }
+        world.refresh();
+
+        auto remap = world.compact();
+        EXPECT(remap.getMoves().size() == 4);
+        EXPECT(getHighestIndex(world) == 5);
+        EXPECT(world.getEntityCount() == 6);
+        EXPECT(movementSystem.getEntities().size() == 6);
+
+        for(auto i : { 1, 4, 6, 7, 8, 9 })
+        {
+            auto entity = remap.remap(entities[i]);
+            EXPECT(entity.isValid());
+            EXPECT(entity.isActivated());
+            EXPECT(entity.getComponent<PositionComponent>().x == static_cast<float>(i));
+            EXPECT(entity.getId().index <= 5);
+            EXPECT(EntityHandle{remap.remap(EntityHandle{entities[i]})} == EntityHandle{entity});
+
+            // the old ID of a moved entity is invalid
+            EXPECT(entities[i].isValid() == (entity == entities[i]));
+        }
+
+        // killed entities stay invalid
+        EXPECT(!remap.remap(entities[0]).isValid());
+
+        for(auto& entity : movementSystem.getEntities())
+        {
+            EXPECT(entity.isValid());
+            EXPECT(entity.hasComponent<VelocityComponent>());
+        }
+
+        // new entities use the indices after the alive entities
+        EXPECT(world.createEntity().getId().index == 6);
+    },
+
+    CASE("Compacting a world with a system that keeps its entities by index")
+    {
+        World world;
+        MovementSystem movementSystem;
+        movementSystem.setEntityOrder(MovementSystem::EntityOrder::INDEX);
+        auto entities = createEntities(world, movementSystem, 10);
+
+        for(auto i : { 0, 2, 3, 5 })
+        {
+            entities[i].kill();
+        }
+        world.compact();
+
+        auto handles = movementSystem.getEntityHandles();
+        EXPECT(handles.size() == 6);
+        for(std::size_t i = 0; i < handles.size(); ++i)
+        {
+            EXPECT(handles[i].getId().index == i);
+        }
+    },
+
+    CASE("Compacting a world with a hierarchy")
+    {
+        World world;
+        MovementSystem movementSystem;
+        auto entities = createEntities(world, movementSystem, 6);
+
+        world.setParent(entities[4], entities[5]);
+        world.setParent(entities[1], entities[4]);
+        entities[0].kill();
+        entities[2].kill();
+        world.refresh();
+
+        auto remap = world.compact();
+        auto parent = remap.remap(entities[5]);
+        auto child = remap.remap(entities[4]);
+        auto grandchild = remap.remap(entities[1]);
+
+        EXPECT(parent.getId().index < 4);
+        EXPECT(child.getId().index < 4);
+        EXPECT(world.getParent(child) == parent);
+        EXPECT(world.getParent(grandchild) == child);
+        EXPECT(world.getChildren(parent).size() == 1);
+        EXPECT(world.getChildren(parent)[0] == child);
+        EXPECT(world.getHierarchy().size() == 3);
+
+        // killing the parent still kills its descendants
+        parent.kill();
+        world.refresh();
+        EXPECT(!child.isValid());
+        EXPECT(!grandchild.isValid());
+        EXPECT(world.getEntityCount() == 1);
+    },
+
+    CASE("Compacting a world with entities killed before refreshing")
+    {
+        World world;
+        MovementSystem movementSystem;
+        auto entities = createEntities(world, movementSystem, 4);
+
+        entities[0].kill();
+        entities[1].kill();
+
+        auto remap = world.compact();
+        EXPECT(world.getEntityCount() == 2);
+        EXPECT(getHighestIndex(world) == 1);
+        EXPECT(remap.remap(entities[3]).getComponent<PositionComponent>().x == 3);
+    },
+
+    CASE("Compacting a world with a system that keeps entities by index")
+    {
+        World world;
+        BroadphaseSystem broadphaseSystem;
+        world.addSystem(broadphaseSystem);
+        MovementSystem movementSystem;
+        auto entities = createEntities(world, movementSystem, 10);
+
+        for(auto i : { 0, 2, 3, 5 })
+        {
+            entities[i].kill();
+        }
+        auto remap = world.compact();
+        EXPECT(remap.getMoves().size() == 4);
+
+        for(auto i : { 1, 4, 6, 7, 8, 9 })
+        {
+            auto entity = remap.remap(entities[i]);
+            EXPECT(broadphaseSystem.grid.contains(entity));
+            EXPECT(broadphaseSystem.sweepAndPrune.contains(entity));
+        }
+        EXPECT(broadphaseSystem.grid.getSize() == 6);
+        EXPECT(broadphaseSystem.sweepAndPrune.getSize() == 6);
+        EXPECT_NO_THROW(broadphaseSystem.update());
+
+        // only 6, 7, 8 and 9 are next to each other
+        std::vector<util::SpatialHashGrid::EntityPair> gridPairs;
+        broadphaseSystem.grid.queryPairs(gridPairs);
+        std::vector<util::SweepAndPrune::EntityPair> sweepPairs;
+        broadphaseSystem.sweepAndPrune.queryPairs(sweepPairs);
+        EXPECT(gridPairs.size() == 3);
+        EXPECT(sweepPairs.size() == 3);
+        for(auto& pair : sweepPairs)
+        {
+            EXPECT(pair.first.isValid());
+            EXPECT(pair.second.isValid());
+        }
+
+        // moved entities are removed from the broadphases by their new IDs
+        remap.remap(entities[9]).kill();
+        EXPECT_NO_THROW(world.refresh());
+        EXPECT(broadphaseSystem.grid.getSize() == 5);
+        EXPECT(broadphaseSystem.sweepAndPrune.getSize() == 5);
+    },
+
+    CASE("Compacting a world incrementally")
+    {
+        World world;
+        MovementSystem movementSystem;
+        auto entities = createEntities(world, movementSystem, 10);
+
+        for(auto i : { 0, 1, 2, 3 })
+        {
+            entities[i].kill();
+        }
+        world.refresh();
+
+        EXPECT(world.compact(1).getMoves().size() == 1);
+        EXPECT(getHighestIndex(world) == 8);
+        EXPECT(world.compact(2).getMoves().size() == 2);
+        EXPECT(getHighestIndex(world) == 6);
+        EXPECT(world.compact().getMoves().size() == 1);
+        EXPECT(getHighestIndex(world) == 5);
+
+        // already dense
+        EXPECT(world.compact().empty());
+        EXPECT(movementSystem.getEntities().size() == 6);
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
@@ -0,0 +1,143 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <anax/anax.hpp>
+using namespace anax;
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Components within a World
+//      ✓ Are components aligned to the alignment of their type (up to and beyond a cache line)?
+//      ✓ Are components aligned across many chunks of their pool?
+//      ✓ Is the stride of a pool a multiple of the alignment?
+// 2. Components within a Prefab
+//      ✓ Are the components of a prefab, and of its instances, aligned?
+// 3. Components within a StaticWorld
+//      ✓ Are components aligned, and kept aligned when the world grows?
+
+namespace
+{
+    /// A component for SIMD operations, aligned to a 256-bit register
+    struct SimdComponent : Component
+    {
+        alignas(32) float values[8];
+    };
+
+    /// A component aligned to a cache line, so that components
+    /// written by different threads never share a cache line
+    struct alignas(64) CacheLineComponent : Component
+    {
+        int value = 0;
+    };
+
+    /// A component aligned beyond a cache line
+    struct alignas(256) PageComponent : Component
+    {
+        char value = 0;
+    };
+
+    template <class T>
+    bool IsAligned(const T& component)
+    {
+        return reinterpret_cast<std::uintptr_t>(&component) % alignof(T) == 0;
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Over-aligned components within a world")
+    {
+        World world;
+
+        // enough entities for several chunks within each pool
+        std::vector<Entity> entities;
+        for(int i = 0; i < 200; ++i)
+        {
+            auto entity = world.createEntity();
+            EXPECT(IsAligned(entity.addComponent<SimdComponent>()));
+            EXPECT(IsAligned(entity.addComponent<CacheLineComponent>()));
+            EXPECT(IsAligned(entity.addComponent<PageComponent>()));
+            entities.push_back(entity);
+        }
+
+        for(auto& entity : entities)
+        {
+            EXPECT(IsAligned(entity.getComponent<SimdComponent>().values[0]));
+            EXPECT(reinterpret_cast<std::uintptr_t>(entity.getComponent<SimdComponent>().values) % 32 == 0);
+        }
+
+        auto report = world.getMemoryReport();
+        EXPECT(report.getComponentMemory<PageComponent>() != nullptr);
+        EXPECT(report.getComponentMemory<PageComponent>()->stride % 256 == 0);
+    },
+
+    CASE("Over-aligned components within a prefab")
+    {
+        World world;
+        Prefab prefab;
+        EXPECT(IsAligned(prefab.addComponent<CacheLineComponent>()));
+        EXPECT(IsAligned(prefab.addComponent<PageComponent>()));
+        prefab.getComponent<CacheLineComponent>().value = 7;
+
+        for(auto& entity : world.instantiate(prefab, 100))
+        {
+            EXPECT(IsAligned(entity.getComponent<CacheLineComponent>()));
+            EXPECT(IsAligned(entity.getComponent<PageComponent>()));
+            EXPECT(entity.getComponent<CacheLineComponent>().value == 7);
+        }
+    },
+
+    CASE("Over-aligned components within a static world")
+    {
+        StaticWorld<SimdComponent, CacheLineComponent, PageComponent> world(1);
+
+        std::vector<Entity::Id> entities;
+        for(int i = 0; i < 100; ++i)
+        {
+            auto entity = world.createEntity();
+            world.addComponent<CacheLineComponent>(entity).value = i;
+            world.addComponent<PageComponent>(entity);
+            entities.push_back(entity);
+        }
+
+        // the world has grown several times
+        for(int i = 0; i < 100; ++i)
+        {
+            EXPECT(IsAligned(world.getComponent<CacheLineComponent>(entities[i])));
+            EXPECT(IsAligned(world.getComponent<PageComponent>(entities[i])));
+            EXPECT(world.getComponent<CacheLineComponent>(entities[i]).value == i);
+        }
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
@@ -0,0 +1,187 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <anax/anax.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+using namespace anax;
+
+#include "Components.hpp"
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Type IDs
+//      ✓ Are registered type IDs the position within the registry?
+//      ✓ Are components that are not registered given other type IDs?
+//      ✓ Registering a registry twice => no failure?
+//      ✓ Registering a component after its type ID is used => failure?
+//      ✓ Registration failed => is the registry not registered?
+// 2. Filters
+//      ✓ Are filters of the registry the same as filters built at run-time?
+//      ✓ Are entities added to systems of the registry?
+//      ✓ Are the components of entities cached by cached systems of the registry?
+//      ✓ Are systems of a registry that is not registered filtered at run-time?
+
+namespace
+{
+    typedef ComponentRegistry<PositionComponent, VelocityComponent, PlayerComponent, NPCComponent> GameComponents;
+
+    static_assert(GameComponents::GetTypeId<PositionComponent>() == 0, "type IDs must be the position within the registry");
+    static_assert(GameComponents::GetTypeId<NPCComponent>() == 3, "type IDs must be the position within the registry");
+
+    struct UnregisteredComponent : Component {};
+    struct LateComponent : Component {};
+
+    class MovementSystem : public GameComponents::System<Requires<PositionComponent, VelocityComponent>>
+    {
+    };
+
+    class PlayerSystem : public GameComponents::System<Requires<PlayerComponent>, Excludes<NPCComponent>>
+    {
+    };
+
+    class CachedMovementSystem : public GameComponents::CachedSystem<Requires<PositionComponent, VelocityComponent>>
+    {
+    };
+
+    typedef ComponentRegistry<LateComponent> LateComponents;
+
+    class LateSystem : public LateComponents::System<Requires<LateComponent>>
+    {
+    };
+}
+
+const lest::test specification[] =
+{
+    CASE("Type IDs of registered components")
+    {
+        EXPECT(GameComponents::IsRegistered());
+        EXPECT(ComponentTypeId<PositionComponent>() == 0);
+        EXPECT(ComponentTypeId<VelocityComponent>() == 1);
+        EXPECT(ComponentTypeId<PlayerComponent>() == 2);
+        EXPECT(ComponentTypeId<NPCComponent>() == 3);
+        EXPECT(ComponentTypeId<UnregisteredComponent>() >= 4);
+
+        GameComponents::Register();
+        EXPECT(ComponentTypeId<PositionComponent>() == 0);
+    },
+
+    CASE("Registering a component after its type ID is used")
+    {
+        ComponentTypeId<LateComponent>();
+        EXPECT_THROWS_AS(LateComponents::Register(), anax::TestException);
+        EXPECT(!LateComponents::IsRegistered());
+    },
+
+    CASE("Systems of a registry that is not registered")
+    {
+        // the type ID of LateComponent is not its position within its registry
+        EXPECT(ComponentTypeId<LateComponent>() != LateComponents::GetTypeId<LateComponent>());
+
+        World world;
+        LateSystem lateSystem;
+        world.addSystem(lateSystem);
+
+        auto late = world.createEntity();
+        late.addComponent<LateComponent>();
+        late.activate();
+
+        auto mover = world.createEntity();
+        mover.addComponent<PositionComponent>();
+        mover.activate();
+
+        world.refresh();
+
+        EXPECT(lateSystem.getEntities().size() == 1);
+        EXPECT(lateSystem.getEntities()[0] == late);
+    },
+
+    CASE("Filters of a registry are the same as filters built at run-time")
+    {
+        auto filter = GameComponents::MakeFilter<Requires<PlayerComponent>, Excludes<NPCComponent>>();
+        auto runtimeFilter = detail::MakeFilter<Requires<PlayerComponent>, Excludes<NPCComponent>>();
+
+        for(unsigned long long typeList = 0; typeList < 16; ++typeList)
+        {
+            detail::ComponentTypeList components{typeList};
+            EXPECT(filter.doesPassFilter(components) == runtimeFilter.doesPassFilter(components));
+        }
+    },
+
+    CASE("Systems of a registry within a world")
+    {
+        World world;
+        MovementSystem movementSystem;
+        PlayerSystem playerSystem;
+        world.addSystem(movementSystem);
+        world.addSystem(playerSystem);
+
+        auto mover = world.createEntity();
+        mover.addComponent<PositionComponent>();
+        mover.addComponent<VelocityComponent>();
+        mover.activate();
+
+        auto player = world.createEntity();
+        player.addComponent<PlayerComponent>();
+        player.activate();
+
+        auto npc = world.createEntity();
+        npc.addComponent<PlayerComponent>();
+        npc.addComponent<NPCComponent>();
+        npc.activate();
+
+        world.refresh();
+
+        EXPECT(movementSystem.getEntities().size() == 1);
+        EXPECT(movementSystem.getEntities()[0] == mover);
+        EXPECT(playerSystem.getEntities().size() == 1);
+        EXPECT(playerSystem.getEntities()[0] == player);
+    },
+
+    CASE("Cached systems of a registry within a world")
+    {
+        World world;
+        CachedMovementSystem movementSystem;
+        world.addSystem(movementSystem);
+
+        auto mover = world.createEntity();
+        mover.addComponent<PositionComponent>();
+        mover.addComponent<VelocityComponent>();
+        mover.activate();
+        world.refresh();
+
+        EXPECT(movementSystem.getComponentTuples().size() == 1);
+        EXPECT(std::get<1>(movementSystem.getComponentTuples()[0]) == &mover.getComponent<PositionComponent>());
+    }
+};
+
+int main()
+{
+    // registered before the type ID of any component is used
+    GameComponents::Register();
+
+    return lest::run(specification);
+}
@@ -26,6 +26,9 @@
 #include <lest.hpp>
 
 #include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include <anax/Entity.hpp>
 #include <anax/World.hpp>
@@ -66,11 +69,77 @@ using namespace anax;
 //      ✓ Adding multiple components => does it assert?
 //      ✓ Removing a component => does hasComponent return false?
 //      ✓ Removing all components => does hasComponent return false?
+//      ✓ Constructor of a component throws => is its memory given back to the pool?
 // 6. Retrieving an entity via index
 //      ✓ Invalid index => invalid entity returned?
 //      ✓  Valid index => appropriate entity returned?
 //      ✓ Multiple entities added/removed => appropriate entity returned?
+// 7. Adding and removing components from multiple entities
+//      ✓ Adding a component => does each entity have its own copy?
+//      ✓ Adding a component to an invalid entity => does it assert?
+// 8. Entity ID layouts
+//      ✓ IDs with different indices and counters => are they different?
+//      ✓ Too many entities for the index bits => does it assert?
+//      ✓ Counter reaches its maximum => is the index retired?
+//      ✓ Layout larger than the bits of an ID => does it assert?
+// 9. Recycling entity IDs
+//      ✓ LIFO => is the most recently freed index re-used?
+//      ✓ FIFO => is the least recently freed index re-used?
+//      ✓ FIFO with a quarantine => are new indices used until enough are free?
+//      ✓ Lowest index first => are the lowest free indices re-used?
+//      ✓ LIFO with a quarantine => are the most recently freed indices held aside?
+//      ✓ Lowest index first with a quarantine => is a quarantined lower index skipped?
+// 10. Replacing components
+//      ✓ Replacing a component => does it keep its address?
+//      ✓ Replacing a component the entity does not have => does it assert?
+//      ✓ Emplacing or replacing => is a component added, then replaced in place?
+//      ✓ Replacing a component within a CachedSystem => is the cached component replaced?
+//      ✓ Adding or removing a component within a CachedSystem, without activating => are the cached components updated?
+//      ✓ Replacing an aggregate => is it constructed in place?
+//      ✓ Constructor throws for a component that cannot be assigned => is the old component kept?
+//      ✓ Removing a component => does hasComponent return false?
+
+
+/// A component whose constructor may throw
+struct ThrowingComponent
+{
+    explicit ThrowingComponent(bool shouldThrow)
+    {
+        if(shouldThrow)
+        {
+            throw std::runtime_error("component could not be constructed");
+        }
+    }
+};
+
+/// A component that cannot be assigned, whose constructor may throw
+struct ConstantComponent
+{
+    const int value;
+
+    ConstantComponent(int v, bool shouldThrow) : value(v)
+    {
+        if(shouldThrow)
+        {
+            throw std::runtime_error("component could not be constructed");
+        }
+    }
+};
+
+/// Caches the components that cannot be assigned, which are replaced by a new component
+struct ConstantSystem : anax::CachedSystem<anax::Requires<ConstantComponent>>
+{
+};
+
+/// An aggregate component, which is constructed in place when replaced
+struct AggregateComponent
+{
+    float x, y;
+};
 
+static_assert(detail::IsNothrowBraceConstructible<AggregateComponent, float, float>::value, "aggregates are constructed with braces");
+static_assert(!detail::IsNothrowBraceConstructible<ConstantComponent, int, bool>::value, "ConstantComponent may throw");
+static_assert(!detail::IsReplacedInPlace<ConstantComponent, int, bool>::value, "ConstantComponent cannot be replaced in place");
 
 template <class Container>
 int countNonNull(const Container& c)
@@ -380,6 +449,23 @@ const lest::test specification[] =
         EXPECT_THROWS_AS(e.getComponent<VelocityComponent>(), anax::TestException);
     },
 
+    CASE("Adding components whose constructor throws")
+    {
+        anax::World world;
+        auto entities = world.createEntities(3);
+
+        EXPECT_THROWS_AS(entities[0].addComponent<ThrowingComponent>(true), std::runtime_error);
+        EXPECT_THROWS_AS(world.addComponents<ThrowingComponent>(entities, true), std::runtime_error);
+        EXPECT(entities[0].hasComponent<ThrowingComponent>() == false);
+
+        entities[1].addComponent<ThrowingComponent>(false);
+
+        auto report = world.getMemoryReport();
+        auto memory = report.getComponentMemory<ThrowingComponent>();
+        EXPECT(memory != nullptr);
+        EXPECT(memory->instanceCount == 1);
+    },
+
     CASE("Retrieving an Entity via ID index (VALID index)")
     {
         anax::World world;
@@ -415,6 +501,362 @@ const lest::test specification[] =
 
         auto e = world.createEntity();
         EXPECT(!(world.getEntity(-1).isValid()));
+    },
+
+    CASE("Adding components to multiple entities")
+    {
+        anax::World world;
+
+        PlayerComponent player;
+        player.name = "player";
+
+        auto entities = world.createEntities(100);
+        world.addComponents<PlayerComponent>(entities, player);
+
+        for(auto& e : entities)
+        {
+            EXPECT(e.hasComponent<PlayerComponent>() == true);
+            EXPECT(e.getComponent<PlayerComponent>().name == "player");
+        }
+
+        entities[0].getComponent<PlayerComponent>().name = "changed";
+        EXPECT(entities[1].getComponent<PlayerComponent>().name == "player");
+    },
+
+    CASE("Adding components to multiple entities (INVALID entity)")
+    {
+        anax::World world;
+
+        auto entities = world.createEntities(10);
+        entities[5].kill();
+        world.refresh();
+
+        EXPECT_THROWS_AS(world.addComponents<PositionComponent>(entities), anax::TestException);
+        EXPECT(entities[0].hasComponent<PositionComponent>() == false);
+    },
+
+    CASE("Removing components from multiple entities")
+    {
+        anax::World world;
+
+        auto entities = world.createEntities(100);
+        world.addComponents<PositionComponent>(entities);
+        world.addComponents<VelocityComponent>(entities);
+
+        world.removeComponents<PositionComponent>(entities);
+
+        for(auto& e : entities)
+        {
+            EXPECT(e.hasComponent<PositionComponent>() == false);
+            EXPECT(e.hasComponent<VelocityComponent>() == true);
+            EXPECT(countNonNull(e.getComponents()) == 1);
+        }
+    },
+
+    CASE("Entity ID values")
+    {
+        // the counter is stored above every bit of the index
+        Entity::Id::int_type highIndex = Entity::Id::int_type(1) << (ANAX_ENTITY_ID_INDEX_BIT_COUNT - 1);
+        EXPECT(Entity::Id(highIndex, 1).value() != Entity::Id(0, 1).value());
+        EXPECT(Entity::Id(highIndex, 1) != Entity::Id(0, 1));
+        EXPECT(Entity::Id(1, 2).value() == ((Entity::Id::int_type(2) << ANAX_ENTITY_ID_INDEX_BIT_COUNT) | 1));
+        EXPECT(Entity::Id(0, 0).isNull());
+        EXPECT(!Entity::Id(0, 1).isNull());
+    },
+
+    CASE("Entity ID layout with few indices")
+    {
+        anax::World world(4, EntityIdLayout{2, 8});
+
+        auto entities = world.createEntities(4);
+        EXPECT(world.getEntityIdLayout().indexBitCount == 2);
+        EXPECT_THROWS_AS(world.createEntity(), anax::TestException);
+
+        // killed indices can still be re-used
+        entities[0].kill();
+        world.refresh();
+        EXPECT(world.createEntity().getId().index == entities[0].getId().index);
+    },
+
+    CASE("Entity ID layout retiring indices")
+    {
+        anax::World world(1, EntityIdLayout{4, 2});
+
+        // the counter of an index may be 1, 2 or 3
+        std::vector<Entity> killed;
+        for(int i = 0; i < 3; ++i)
+        {
+            auto e = world.createEntity();
+            EXPECT(e.getId().index == 0);
+            EXPECT(e.getId().counter == static_cast<Entity::Id::int_type>(i + 1));
+            e.kill();
+            world.refresh();
+            killed.push_back(e);
+        }
+
+        EXPECT(world.getRetiredEntityIndexCount() == 1);
+
+        auto e = world.createEntity();
+        EXPECT(e.getId().index == 1);
+        EXPECT(e.isValid());
+        for(auto& old : killed)
+        {
+            EXPECT(!old.isValid());
+        }
+    },
+
+    CASE("Entity ID layout larger than an ID")
+    {
+        EXPECT(EntityIdLayout{}.isValid());
+        EXPECT(!EntityIdLayout(ANAX_ENTITY_ID_INDEX_BIT_COUNT + 1, 1).isValid());
+        EXPECT(!EntityIdLayout(1, 0).isValid());
+        EXPECT_THROWS_AS(anax::World(1, EntityIdLayout(1, ANAX_ENTITY_ID_COUNTER_BIT_COUNT + 1)), anax::TestException);
+    },
+
+    CASE("Recycling entity IDs (LIFO)")
+    {
+        anax::World world;
+
+        auto entities = world.createEntities(10);
+        entities[2].kill();
+        entities[7].kill();
+        world.refresh();
+
+        EXPECT(world.createEntity().getId().index == entities[7].getId().index);
+        EXPECT(world.createEntity().getId().index == entities[2].getId().index);
+    },
+
+    CASE("Recycling entity IDs (FIFO)")
+    {
+        anax::World world(10, EntityIdLayout{}, EntityIdRecycling{EntityIdRecyclingOrder::FIFO});
+
+        auto entities = world.createEntities(10);
+        entities[2].kill();
+        entities[7].kill();
+        world.refresh();
+
+        EXPECT(world.createEntity().getId().index == entities[2].getId().index);
+        EXPECT(world.createEntity().getId().index == entities[7].getId().index);
+    },
+
+    CASE("Recycling entity IDs (FIFO with a quarantine)")
+    {
+        anax::World world(10, EntityIdLayout{}, EntityIdRecycling{EntityIdRecyclingOrder::FIFO, 2});
+
+        auto entities = world.createEntities(10);
+        entities[2].kill();
+        entities[7].kill();
+        world.refresh();
+
+        // only two indices are free, new indices are used
+        auto e = world.createEntity();
+        EXPECT(e.getId().index == 10);
+        EXPECT(e.isValid());
+
+        entities[4].kill();
+        world.refresh();
+
+        EXPECT(world.createEntity().getId().index == entities[2].getId().index);
+        EXPECT(world.createEntity().getId().index == 11);
+        EXPECT(world.getEntityCount() == 10);
+    },
+
+    CASE("Recycling entity IDs (lowest index first)")
+    {
+        anax::World world(10, EntityIdLayout{}, EntityIdRecycling{EntityIdRecyclingOrder::LOWEST_INDEX_FIRST});
+
+        auto entities = world.createEntities(10);
+        entities[5].kill();
+        entities[2].kill();
+        entities[8].kill();
+        world.refresh();
+
+        EXPECT(world.createEntity().getId().index == 2);
+        EXPECT(world.createEntity().getId().index == 5);
+
+        entities[0].kill();
+        world.refresh();
+
+        EXPECT(world.createEntity().getId().index == 0);
+        EXPECT(world.createEntity().getId().index == 8);
+        EXPECT(world.createEntity().getId().index == 10);
+    },
+
+    CASE("Recycling entity IDs (LIFO with a quarantine)")
+    {
+        anax::World world(10, EntityIdLayout{}, EntityIdRecycling{EntityIdRecyclingOrder::LIFO, 2});
+
+        auto entities = world.createEntities(10);
+        entities[2].kill();
+        world.refresh();
+        entities[7].kill();
+        world.refresh();
+
+        // both indices are quarantined, a new index is used
+        EXPECT(world.createEntity().getId().index == 10);
+
+        entities[4].kill();
+        world.refresh();
+        entities[5].kill();
+        world.refresh();
+
+        // 2 and 7 left the quarantine, 4 and 5 are held aside
+        EXPECT(world.createEntity().getId().index == entities[7].getId().index);
+        EXPECT(world.createEntity().getId().index == entities[2].getId().index);
+        EXPECT(world.createEntity().getId().index == 11);
+    },
+
+    CASE("Recycling entity IDs (lowest index first with a quarantine)")
+    {
+        anax::World world(10, EntityIdLayout{}, EntityIdRecycling{EntityIdRecyclingOrder::LOWEST_INDEX_FIRST, 1});
+
+        auto entities = world.createEntities(10);
+        entities[8].kill();
+        world.refresh();
+        entities[5].kill();
+        world.refresh();
+        entities[2].kill();
+        world.refresh();
+
+        // 2 is the lowest free index, but was freed most recently
+        EXPECT(world.createEntity().getId().index == 5);
+        EXPECT(world.createEntity().getId().index == 8);
+        EXPECT(world.createEntity().getId().index == 10);
+    },
+
+    CASE("Replacing components")
+    {
+        anax::World world;
+        auto e = world.createEntity();
+
+        auto& player = e.addComponent<PlayerComponent>();
+        player.name = "original";
+
+        PlayerComponent replacement;
+        replacement.name = "replaced";
+        EXPECT(&e.replaceComponent<PlayerComponent>(replacement) == &player);
+        EXPECT(e.getComponent<PlayerComponent>().name == "replaced");
+
+        auto& position = e.addComponent<PositionComponent>();
+        position.x = 5;
+        EXPECT(&e.replaceComponent<PositionComponent>() == &position);
+        EXPECT(e.getComponent<PositionComponent>().x == 0);
+    },
+
+    CASE("Replacing a component the entity does not have")
+    {
+        anax::World world;
+        auto e = world.createEntity();
+
+        EXPECT_THROWS_AS(e.replaceComponent<PlayerComponent>(), anax::TestException);
+        EXPECT(e.hasComponent<PlayerComponent>() == false);
+    },
+
+    CASE("Emplacing or replacing components")
+    {
+        anax::World world;
+        auto e = world.createEntity();
+
+        auto& player = e.emplaceOrReplace<PlayerComponent>();
+        EXPECT(e.hasComponent<PlayerComponent>());
+
+        for(int i = 0; i < 10; ++i)
+        {
+            PlayerComponent replacement;
+            replacement.name = std::to_string(i);
+            EXPECT(&e.emplaceOrReplace<PlayerComponent>(std::move(replacement)) == &player);
+        }
+
+        EXPECT(player.name == "9");
+        EXPECT(world.getMemoryReport().getComponentMemory<PlayerComponent>()->instanceCount == 1);
+    },
+
+    CASE("Replacing components within a CachedSystem")
+    {
+        anax::World world;
+        CachedMovementSystem movementSystem;
+        world.addSystem(movementSystem);
+
+        auto e = world.createEntity();
+        e.addComponent<PositionComponent>();
+        e.addComponent<VelocityComponent>();
+        e.activate();
+        world.refresh();
+        movementSystem.update();
+
+        VelocityComponent velocity;
+        velocity.x = 2;
+        velocity.y = 3;
+        e.emplaceOrReplace<VelocityComponent>(velocity);
+        movementSystem.update();
+
+        EXPECT(e.getComponent<PositionComponent>().x == 2);
+        EXPECT(e.getComponent<PositionComponent>().y == 3);
+    },
+
+    CASE("Changing components within a CachedSystem without activating again")
+    {
+        anax::World world;
+        CachedMovementSystem movementSystem;
+        ConstantSystem constantSystem;
+        world.addSystem(movementSystem);
+        world.addSystem(constantSystem);
+
+        auto e = world.createEntity();
+        e.addComponent<PositionComponent>();
+        e.addComponent<VelocityComponent>();
+        e.addComponent<ConstantComponent>(1, false);
+        e.activate();
+        world.refresh();
+        EXPECT(movementSystem.getComponentTuples().size() == 1u);
+        EXPECT(constantSystem.getComponentTuples().size() == 1u);
+
+        // adding a component the entity has puts it within a new slot
+        auto& velocity = e.addComponent<VelocityComponent>();
+        EXPECT(std::get<2>(movementSystem.getComponentTuples()[0]) == &velocity);
+
+        // a component that cannot be assigned is replaced by a new component
+        auto& constant = e.replaceComponent<ConstantComponent>(2, false);
+        EXPECT(std::get<1>(constantSystem.getComponentTuples()[0]) == &constant);
+        EXPECT(std::get<1>(constantSystem.getComponentTuples()[0])->value == 2);
+
+        // the entity no longer has its required components
+        e.removeComponent<VelocityComponent>();
+        EXPECT(movementSystem.getComponentTuples().empty());
+        EXPECT(constantSystem.getComponentTuples().size() == 1u);
+
+        world.refresh();
+        EXPECT(movementSystem.getEntities().size() == 1u);
+        e.activate();
+        world.refresh();
+        EXPECT(movementSystem.getEntities().empty());
+    },
+
+    CASE("Replacing aggregate components")
+    {
+        anax::World world;
+        auto e = world.createEntity();
+
+        auto& aggregate = e.addComponent<AggregateComponent>(1.0f, 2.0f);
+        EXPECT(&e.replaceComponent<AggregateComponent>(3.0f, 4.0f) == &aggregate);
+        EXPECT(aggregate.x == 3.0f);
+        EXPECT(aggregate.y == 4.0f);
+    },
+
+    CASE("Replacing a component that cannot be assigned, whose constructor throws")
+    {
+        anax::World world;
+        auto e = world.createEntity();
+        e.addComponent<ConstantComponent>(1, false);
+
+        EXPECT_THROWS_AS(e.replaceComponent<ConstantComponent>(2, true), std::runtime_error);
+        EXPECT(e.hasComponent<ConstantComponent>());
+        EXPECT(e.getComponent<ConstantComponent>().value == 1);
+
+        EXPECT(e.replaceComponent<ConstantComponent>(3, false).value == 3);
+
+        auto report = world.getMemoryReport();
+        EXPECT(report.getComponentMemory<ConstantComponent>()->instanceCount == 1);
     }
 };
 
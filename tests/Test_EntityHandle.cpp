@@ -0,0 +1,144 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <vector>
+
+#include <anax/anax.hpp>
+using namespace anax;
+
+#include "Components.hpp"
+#include "Systems.hpp"
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Handles
+//      ✓ Is a handle the size of an ID?
+//      ✓ Does a handle resolve to the entity it was created from?
+//      ✓ Is a handle invalid after its entity is killed?
+//      ✓ Is a handle invalid after the index of its entity is reused?
+// 2. Storing handles
+//      ✓ Can a handle be stored within a component?
+//      ✓ Do systems and worlds iterate the entities of their handles?
+
+namespace
+{
+    struct TargetComponent : Component
+    {
+        EntityHandle target;
+    };
+}
+
+const lest::test specification[] =
+{
+    CASE("Size of a handle")
+    {
+        EXPECT(sizeof(EntityHandle) == sizeof(Entity::Id::int_type));
+        EXPECT(sizeof(EntityHandle) < sizeof(Entity));
+        EXPECT(EntityHandle{}.isNull());
+    },
+
+    CASE("Resolving a handle")
+    {
+        World world;
+        auto entity = world.createEntity();
+        EntityHandle handle = entity;
+
+        EXPECT(!handle.isNull());
+        EXPECT(handle.getId() == entity.getId());
+        EXPECT(handle.resolve(world) == entity);
+        EXPECT(handle == EntityHandle{entity.getId()});
+        EXPECT(world.isValid(handle));
+    },
+
+    CASE("Handle of a killed entity")
+    {
+        World world;
+        auto entity = world.createEntity();
+        EntityHandle handle = entity;
+
+        entity.kill();
+        world.refresh();
+        EXPECT(!world.isValid(handle));
+
+        // the index of the killed entity is reused
+        auto other = world.createEntity();
+        EXPECT(other.getId().index == handle.getId().index);
+        EXPECT(!world.isValid(handle));
+        EXPECT(EntityHandle{other} != handle);
+    },
+
+    CASE("Storing a handle within a component")
+    {
+        World world;
+        auto target = world.createEntity();
+        target.addComponent<PositionComponent>().x = 4;
+
+        auto follower = world.createEntity();
+        follower.addComponent<TargetComponent>().target = target;
+
+        auto handle = follower.getComponent<TargetComponent>().target;
+        EXPECT(world.isValid(handle));
+        EXPECT(handle.resolve(world).getComponent<PositionComponent>().x == 4);
+    },
+
+    CASE("Iterating the entities of systems and worlds")
+    {
+        World world;
+        MovementSystem movementSystem;
+        world.addSystem(movementSystem);
+
+        std::vector<Entity> movers;
+        for(int i = 0; i < 10; ++i)
+        {
+            auto entity = world.createEntity();
+            entity.addComponent<PositionComponent>();
+            entity.addComponent<VelocityComponent>();
+            entity.activate();
+            movers.push_back(entity);
+        }
+        world.createEntity();
+        world.refresh();
+
+        EXPECT(movementSystem.getEntityHandles().size() == movers.size());
+        std::vector<Entity> entities = movementSystem.getEntities();
+        EXPECT(entities == movers);
+
+        std::size_t count = 0;
+        for(auto& entity : world.getEntities())
+        {
+            EXPECT(entity.isValid());
+            ++count;
+        }
+        EXPECT(count == 11);
+        EXPECT(world.getEntityHandles().size() == 11);
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
@@ -0,0 +1,202 @@
+///
+/// anax tests
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <algorithm>
+
+#include <anax/World.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+
+#include "Components.hpp"
+#include "Systems.hpp"
+
+using namespace anax;
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Setting parents
+//      ✓ New entity => has no parent?
+//      ✓ Set parent => correct parent and children returned?
+//      ✓ Set parent to itself or a descendant => does it assert?
+//      ✓ Remove parent => has no parent?
+// 2. Hierarchy order
+//      ✓ Are parents before their children?
+//      ✓ Are the children of an entity contiguous?
+// 3. Killing entities
+//      ✓ Kill parent => are the descendants killed?
+//      ✓ Kill parent => are the descendants removed from systems?
+//      ✓ Kill parent and child => is the id of the child recycled once?
+
+const lest::test specification[] =
+{
+    CASE("New entity: no parent or children")
+    {
+        World world;
+        auto e = world.createEntity();
+
+        EXPECT(world.getParent(e).isValid() == false);
+        EXPECT(world.getChildren(e).empty());
+        EXPECT(world.getHierarchy().empty());
+    },
+
+    CASE("Setting the parent of an entity")
+    {
+        World world;
+        auto parent = world.createEntity();
+        auto child1 = world.createEntity();
+        auto child2 = world.createEntity();
+
+        world.setParent(child1, parent);
+        world.setParent(child2, parent);
+
+        EXPECT(world.getParent(child1) == parent);
+        EXPECT(world.getParent(child2) == parent);
+
+        auto children = world.getChildren(parent);
+        EXPECT(children.size() == 2);
+        EXPECT(std::count(children.begin(), children.end(), child1) == 1);
+        EXPECT(std::count(children.begin(), children.end(), child2) == 1);
+    },
+
+    CASE("Setting the parent of an entity to itself or a descendant")
+    {
+        World world;
+        auto e1 = world.createEntity();
+        auto e2 = world.createEntity();
+        auto e3 = world.createEntity();
+
+        world.setParent(e2, e1);
+        world.setParent(e3, e2);
+
+        EXPECT_THROWS_AS(world.setParent(e1, e1), anax::TestException);
+        EXPECT_THROWS_AS(world.setParent(e1, e3), anax::TestException);
+    },
+
+    CASE("Removing the parent of an entity")
+    {
+        World world;
+        auto parent = world.createEntity();
+        auto child = world.createEntity();
+
+        world.setParent(child, parent);
+        world.removeParent(child);
+
+        EXPECT(world.getParent(child).isValid() == false);
+        EXPECT(world.getChildren(parent).empty());
+        EXPECT(world.getHierarchy().empty());
+    },
+
+    CASE("Hierarchy is ordered by depth with contiguous children")
+    {
+        World world;
+        auto entities = world.createEntities(7);
+
+        // build the hierarchy in an arbitrary order
+        world.setParent(entities[6], entities[2]);
+        world.setParent(entities[1], entities[0]);
+        world.setParent(entities[5], entities[2]);
+        world.setParent(entities[2], entities[0]);
+        world.setParent(entities[3], entities[1]);
+        world.setParent(entities[4], entities[6]);
+
+        auto& hierarchy = world.getHierarchy();
+        EXPECT(hierarchy.size() == 7);
+        EXPECT(hierarchy[0].entity == entities[0]);
+        EXPECT(hierarchy[0].parent == detail::EntityHierarchy::NO_PARENT);
+
+        for(std::size_t i = 1; i < hierarchy.size(); ++i)
+        {
+            // parents come before their children
+            EXPECT(hierarchy[i].parent < i);
+            EXPECT(hierarchy[hierarchy[i].parent].entity == world.getParent(hierarchy[i].entity));
+
+            // children of the same parent are contiguous
+            if(hierarchy[i - 1].parent != detail::EntityHierarchy::NO_PARENT)
+            {
+                EXPECT(hierarchy[i - 1].parent <= hierarchy[i].parent);
+            }
+        }
+    },
+
+    CASE("Killing a parent kills its descendants")
+    {
+        World world;
+        MovementSystem movementSystem;
+        world.addSystem(movementSystem);
+
+        auto entities = world.createEntities(4);
+        for(auto& e : entities)
+        {
+            e.addComponent<PositionComponent>();
+            e.addComponent<VelocityComponent>();
+            e.activate();
+        }
+
+        world.setParent(entities[1], entities[0]);
+        world.setParent(entities[2], entities[1]);
+        world.refresh();
+
+        EXPECT(movementSystem.getEntities().size() == 4);
+
+        entities[0].kill();
+        world.refresh();
+
+        EXPECT(entities[0].isValid() == false);
+        EXPECT(entities[1].isValid() == false);
+        EXPECT(entities[2].isValid() == false);
+        EXPECT(entities[3].isValid() == true);
+        EXPECT(world.getEntityCount() == 1);
+        EXPECT(movementSystem.getEntities().size() == 1);
+        EXPECT(world.getHierarchy().empty());
+    },
+
+    CASE("Killing a parent and its child")
+    {
+        World world;
+        auto parent = world.createEntity();
+        auto child = world.createEntity();
+        world.setParent(child, parent);
+
+        child.kill();
+        parent.kill();
+        world.refresh();
+
+        EXPECT(world.getEntityCount() == 0);
+
+        // each id should only be recycled once
+        auto e1 = world.createEntity();
+        auto e2 = world.createEntity();
+        auto e3 = world.createEntity();
+        EXPECT(e1.getId().index != e2.getId().index);
+        EXPECT(e1.getId().index != e3.getId().index);
+        EXPECT(e2.getId().index != e3.getId().index);
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
@@ -0,0 +1,217 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <anax/anax.hpp>
+using namespace anax;
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Components that do not derive from Component
+//      ✓ Which types may be components?
+//      ✓ Can plain components be added, retrieved and removed?
+//      ✓ Are plain components stored without a vtable pointer?
+//      ✓ Are plain components destroyed when removed or killed?
+//      ✓ Can move-only plain components be used?
+// 2. Plain components within systems and prefabs
+//      ✓ Are entities with plain components added to systems?
+//      ✓ Are plain components copied to the instances of a prefab?
+// 3. Plain components within a StaticWorld
+//      ✓ Are plain components kept when the world grows?
+
+namespace
+{
+    /// A trivially copyable component
+    struct PlainVelocity
+    {
+        float x, y;
+    };
+
+    /// A component that is not trivially destructible
+    struct PlainName
+    {
+        static int destroyedCount;
+
+        std::string name;
+
+        PlainName(std::string n) : name(std::move(n)) {}
+        PlainName(const PlainName&) = default;
+        ~PlainName() { ++destroyedCount; }
+    };
+
+    int PlainName::destroyedCount = 0;
+
+    /// A component that may only be moved
+    struct PlainOwner
+    {
+        std::unique_ptr<int> value;
+    };
+
+    struct PlainMovementSystem : System<Requires<PlainVelocity>, Excludes<PlainName>>
+    {
+    };
+
+    static_assert(IsComponent<PlainVelocity>::value, "plain structs are components");
+    static_assert(IsComponent<int>::value, "scalars are components");
+    static_assert(!IsComponent<const PlainVelocity>::value, "const types are not components");
+    static_assert(!IsComponent<PlainVelocity&>::value, "references are not components");
+    static_assert(!IsComponent<int[4]>::value, "arrays are not components");
+    static_assert(!IsComponent<void>::value, "void is not a component");
+    static_assert(std::is_trivially_copyable<PlainVelocity>::value, "plain components may be trivially copyable");
+}
+
+const lest::test specification[] =
+{
+    CASE("Adding, retrieving and removing plain components")
+    {
+        World world;
+        auto entity = world.createEntity();
+
+        entity.addComponent<PlainVelocity>(PlainVelocity{1, 2});
+        entity.addComponent<int>(5);
+
+        EXPECT(entity.hasComponent<PlainVelocity>());
+        EXPECT(entity.getComponent<PlainVelocity>().y == 2);
+        EXPECT(entity.getComponent<int>() == 5);
+        EXPECT(entity.getComponentTypeList()[ComponentTypeId<PlainVelocity>()]);
+
+        // plain components do not derive from Component
+        for(auto component : entity.getComponents())
+        {
+            EXPECT(component == nullptr);
+        }
+
+        entity.removeComponent<PlainVelocity>();
+        EXPECT(!entity.hasComponent<PlainVelocity>());
+        EXPECT(entity.hasComponent<int>());
+    },
+
+    CASE("Plain components are stored without a vtable pointer")
+    {
+        World world;
+        world.createEntity().addComponent<PlainVelocity>();
+
+        auto report = world.getMemoryReport();
+        EXPECT(report.getComponentMemory<PlainVelocity>() != nullptr);
+        EXPECT(report.getComponentMemory<PlainVelocity>()->stride == 2 * sizeof(float));
+    },
+
+    CASE("Plain components are destroyed")
+    {
+        PlainName::destroyedCount = 0;
+        {
+            World world;
+            auto first = world.createEntity();
+            auto second = world.createEntity();
+            auto third = world.createEntity();
+            first.addComponent<PlainName>("first");
+            second.addComponent<PlainName>("second");
+            third.addComponent<PlainName>("third");
+            world.refresh();
+
+            first.removeComponent<PlainName>();
+            EXPECT(PlainName::destroyedCount == 1);
+
+            second.kill();
+            world.refresh();
+            EXPECT(PlainName::destroyedCount == 2);
+        }
+        EXPECT(PlainName::destroyedCount == 3);
+    },
+
+    CASE("Move-only plain components")
+    {
+        World world;
+        auto entity = world.createEntity();
+        entity.addComponent<PlainOwner>(PlainOwner{std::unique_ptr<int>(new int(3))});
+        EXPECT(*entity.getComponent<PlainOwner>().value == 3);
+    },
+
+    CASE("Entities with plain components are added to systems")
+    {
+        World world;
+        PlainMovementSystem system;
+        world.addSystem(system);
+
+        auto moving = world.createEntity();
+        moving.addComponent<PlainVelocity>();
+        moving.activate();
+
+        auto named = world.createEntity();
+        named.addComponent<PlainVelocity>();
+        named.addComponent<PlainName>("named");
+        named.activate();
+
+        world.refresh();
+
+        EXPECT(system.getEntities().size() == 1);
+        EXPECT(system.getEntities()[0] == moving);
+    },
+
+    CASE("Plain components are copied to the instances of a prefab")
+    {
+        World world;
+        Prefab prefab;
+        prefab.addComponent<PlainVelocity>(PlainVelocity{3, 4});
+        prefab.addComponent<PlainName>("prefab");
+
+        for(auto& entity : world.instantiate(prefab, 50))
+        {
+            EXPECT(entity.getComponent<PlainVelocity>().x == 3);
+            EXPECT(entity.getComponent<PlainVelocity>().y == 4);
+            EXPECT(entity.getComponent<PlainName>().name == "prefab");
+        }
+    },
+
+    CASE("Plain components are kept when a static world grows")
+    {
+        StaticWorld<PlainVelocity, PlainName> world(1);
+
+        std::vector<Entity::Id> entities;
+        for(int i = 0; i < 100; ++i)
+        {
+            auto entity = world.createEntity();
+            world.addComponent<PlainVelocity>(entity, static_cast<float>(i), 0.0f);
+            world.addComponent<PlainName>(entity, std::to_string(i));
+            entities.push_back(entity);
+        }
+
+        for(int i = 0; i < 100; ++i)
+        {
+            EXPECT(world.getComponent<PlainVelocity>(entities[i]).x == i);
+            EXPECT(world.getComponent<PlainName>(entities[i]).name == std::to_string(i));
+        }
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
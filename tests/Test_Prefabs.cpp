@@ -0,0 +1,161 @@
+///
+/// anax tests
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <anax/World.hpp>
+#include <anax/Prefab.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+
+#include "Components.hpp"
+#include "Systems.hpp"
+
+using namespace anax;
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Building a prefab
+//      ✓ Adding a component => does hasComponent return true?
+//      ✓ Replacing a component => is the new component used?
+//      ✓ Removing a component => does hasComponent return false?
+// 2. Instantiating a prefab
+//      ✓ Are the amount of entities created valid?
+//      ✓ Do the entities have copies of the prefab's components?
+//      ✓ Are the copies independent of the prefab?
+//      ✓ Are the entities added to systems after a refresh?
+
+const lest::test specification[] =
+{
+    CASE("Adding components to a prefab")
+    {
+        Prefab prefab;
+        prefab.addComponent<PositionComponent>();
+
+        EXPECT(prefab.hasComponent<PositionComponent>() == true);
+        EXPECT(prefab.hasComponent<VelocityComponent>() == false);
+        EXPECT_NO_THROW(prefab.getComponent<PositionComponent>());
+        EXPECT_THROWS_AS(prefab.getComponent<VelocityComponent>(), anax::TestException);
+    },
+
+    CASE("Replacing components of a prefab")
+    {
+        Prefab prefab;
+        prefab.addComponent<PlayerComponent>().name = "first";
+        prefab.addComponent<PlayerComponent>().name = "second";
+
+        EXPECT(prefab.getComponent<PlayerComponent>().name == "second");
+    },
+
+    CASE("Removing components from a prefab")
+    {
+        Prefab prefab;
+        prefab.addComponent<PositionComponent>();
+        prefab.removeComponent<PositionComponent>();
+
+        EXPECT(prefab.hasComponent<PositionComponent>() == false);
+        EXPECT(prefab.getComponentTypeList().none());
+    },
+
+    CASE("Instantiating a prefab")
+    {
+        World world;
+
+        Prefab prefab;
+        auto& position = prefab.addComponent<PositionComponent>();
+        position.x = 1; position.y = 2; position.z = 3;
+        prefab.addComponent<PlayerComponent>().name = "bullet";
+
+        auto entities = world.instantiate(prefab, 1000);
+
+        EXPECT(entities.size() == 1000);
+        EXPECT(world.getEntityCount() == 1000);
+
+        for(auto& e : entities)
+        {
+            EXPECT(e.isValid());
+            EXPECT(e.getComponent<PositionComponent>().y == 2);
+            EXPECT(e.getComponent<PlayerComponent>().name == "bullet");
+            EXPECT(e.hasComponent<VelocityComponent>() == false);
+        }
+    },
+
+    CASE("Instances of a prefab are independent")
+    {
+        World world;
+
+        Prefab prefab;
+        prefab.addComponent<PlayerComponent>().name = "bullet";
+
+        auto entities = world.instantiate(prefab, 2);
+        entities[0].getComponent<PlayerComponent>().name = "changed";
+
+        EXPECT(entities[1].getComponent<PlayerComponent>().name == "bullet");
+        EXPECT(prefab.getComponent<PlayerComponent>().name == "bullet");
+        EXPECT(&entities[0].getComponent<PlayerComponent>() != &entities[1].getComponent<PlayerComponent>());
+    },
+
+    CASE("Instances of a prefab are activated")
+    {
+        World world;
+        MovementSystem movementSystem;
+        world.addSystem(movementSystem);
+
+        Prefab prefab;
+        prefab.addComponent<PositionComponent>();
+        prefab.addComponent<VelocityComponent>();
+
+        auto entities = world.instantiate(prefab, 100);
+        EXPECT(movementSystem.getEntities().size() == 0);
+
+        world.refresh();
+
+        EXPECT(movementSystem.getEntities().size() == 100);
+        EXPECT(entities[0].isActivated() == true);
+    },
+
+    CASE("Killing instances of a prefab")
+    {
+        World world;
+
+        Prefab prefab;
+        prefab.addComponent<PlayerComponent>().name = "bullet";
+
+        auto entities = world.instantiate(prefab, 100);
+        world.killEntities(entities);
+        world.refresh();
+
+        EXPECT(world.getEntityCount() == 0);
+        EXPECT(entities[0].isValid() == false);
+
+        // re-use the memory of the killed instances
+        auto newEntities = world.instantiate(prefab, 100);
+        EXPECT(newEntities[99].getComponent<PlayerComponent>().name == "bullet");
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
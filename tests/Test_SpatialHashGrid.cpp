@@ -0,0 +1,170 @@
+///
+/// anax tests
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include <anax/World.hpp>
+#include <anax/util/SpatialHashGrid.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+
+using namespace anax;
+using util::SpatialHashGrid;
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Inserting/removing entities
+//      ✓ Insert entity => is it contained?
+//      ✓ Insert entity twice => does it assert?
+//      ✓ Remove entity => is it no longer contained?
+// 2. Queries
+//      ✓ Range query => are only overlapping entities found?
+//      ✓ Large entity spanning many cells => reported once?
+//      ✓ Pair query => does it match a brute force check?
+//      ✓ Update bounds => are queries correct after moving?
+
+namespace
+{
+    SpatialHashGrid::Bounds makeBounds(float x, float y, float width, float height)
+    {
+        return SpatialHashGrid::Bounds{x, y, x + width, y + height};
+    }
+
+    std::size_t countBruteForcePairs(const std::vector<SpatialHashGrid::Bounds>& bounds)
+    {
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < bounds.size(); ++i)
+            for(std::size_t j = i + 1; j < bounds.size(); ++j)
+                if(bounds[i].intersects(bounds[j]))
+                    ++count;
+        return count;
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Inserting entities into a grid")
+    {
+        World world;
+        SpatialHashGrid grid{10};
+
+        auto e = world.createEntity();
+        grid.insert(e, makeBounds(0, 0, 5, 5));
+
+        EXPECT(grid.contains(e) == true);
+        EXPECT(grid.getSize() == 1);
+        EXPECT_THROWS_AS(grid.insert(e, makeBounds(0, 0, 5, 5)), anax::TestException);
+    },
+
+    CASE("Removing entities from a grid")
+    {
+        World world;
+        SpatialHashGrid grid{10};
+
+        auto e = world.createEntity();
+        grid.insert(e, makeBounds(0, 0, 5, 5));
+        grid.remove(e);
+
+        EXPECT(grid.contains(e) == false);
+        EXPECT(grid.getSize() == 0);
+
+        std::vector<Entity> found;
+        grid.query(makeBounds(-100, -100, 200, 200), found);
+        EXPECT(found.empty());
+    },
+
+    CASE("Querying an area of a grid")
+    {
+        World world;
+        SpatialHashGrid grid{10};
+
+        auto inside = world.createEntity();
+        auto outside = world.createEntity();
+        auto large = world.createEntity();
+
+        grid.insert(inside, makeBounds(12, 12, 2, 2));
+        grid.insert(outside, makeBounds(-30, -30, 2, 2));
+        grid.insert(large, makeBounds(-50, -50, 100, 100));
+
+        std::vector<Entity> found;
+        grid.query(makeBounds(0, 0, 20, 20), found);
+
+        EXPECT(found.size() == 2);
+        EXPECT(std::count(found.begin(), found.end(), inside) == 1);
+        EXPECT(std::count(found.begin(), found.end(), large) == 1);
+    },
+
+    CASE("Querying pairs of a grid")
+    {
+        World world;
+        SpatialHashGrid grid{8};
+
+        std::mt19937 random{42};
+        std::uniform_real_distribution<float> position{-100, 100};
+        std::uniform_real_distribution<float> size{1, 20};
+
+        std::vector<SpatialHashGrid::Bounds> bounds;
+        for(auto& e : world.createEntities(500))
+        {
+            bounds.push_back(makeBounds(position(random), position(random), size(random), size(random)));
+            grid.insert(e, bounds.back());
+        }
+
+        std::vector<SpatialHashGrid::EntityPair> pairs;
+        grid.queryPairs(pairs);
+
+        EXPECT(pairs.size() == countBruteForcePairs(bounds));
+    },
+
+    CASE("Updating the bounds of entities within a grid")
+    {
+        World world;
+        SpatialHashGrid grid{10};
+
+        auto e1 = world.createEntity();
+        auto e2 = world.createEntity();
+        grid.insert(e1, makeBounds(0, 0, 5, 5));
+        grid.insert(e2, makeBounds(100, 100, 5, 5));
+
+        std::vector<SpatialHashGrid::EntityPair> pairs;
+        grid.queryPairs(pairs);
+        EXPECT(pairs.empty());
+
+        grid.update(e2, makeBounds(2, 2, 5, 5));
+        grid.queryPairs(pairs);
+        EXPECT(pairs.size() == 1);
+
+        std::vector<Entity> found;
+        grid.query(makeBounds(100, 100, 5, 5), found);
+        EXPECT(found.empty());
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
@@ -0,0 +1,188 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <anax/anax.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+using namespace anax;
+
+#include "Components.hpp"
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Hashing names
+//      ✓ Is the key the 64-bit FNV-1a hash of the name?
+//      ✓ Is the key of a name a constant expression?
+// 2. Registering components by name
+//      ✓ Are keys mapped to the type IDs of components, and back?
+//      ✓ Are components that are not registered given no key?
+//      ✓ Registering more components than the bits of a type list => no collision?
+//      ✓ Two names with the same key => failure naming both?
+//      ✓ A name registered to two types => failure?
+//      ✓ A type registered with two names => failure?
+// 3. Persisting components by key
+//      ✓ Is a type list remapped through the key table the same after a round trip?
+
+namespace
+{
+    static_assert(StableComponentKey("a") == 0xaf63dc4c8601ec8cULL, "stable keys must be constant expressions");
+
+    struct RenamedComponent : Component {};
+    struct DuplicateComponent : Component {};
+    struct UnregisteredComponent : Component {};
+
+    template <int N>
+    struct NumberedComponent : Component {};
+
+    /// Registers NumberedComponent<0> to NumberedComponent<N - 1>
+    template <int N>
+    struct RegisterNumberedComponents
+    {
+        static bool Register()
+        {
+            auto name = "NumberedComponent" + std::to_string(N - 1);
+            bool isRegistered = RegisterStableComponentKey<NumberedComponent<N - 1>>(name.c_str()) != INVALID_STABLE_COMPONENT_KEY;
+            return RegisterNumberedComponents<N - 1>::Register() && isRegistered;
+        }
+    };
+
+    template <>
+    struct RegisterNumberedComponents<0>
+    {
+        static bool Register() { return true; }
+    };
+
+    /// \return true if an exception was thrown with a message containing both names
+    template <class Function>
+    bool ThrowsNaming(Function function, const char* first, const char* second)
+    {
+        try
+        {
+            function();
+        }
+        catch(const anax::TestException& exception)
+        {
+            return std::strstr(exception.what(), first) && std::strstr(exception.what(), second);
+        }
+        return false;
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Hashing names")
+    {
+        EXPECT(detail::HashName("") == 0xcbf29ce484222325ULL);
+        EXPECT(detail::HashName("a") == 0xaf63dc4c8601ec8cULL);
+        EXPECT(detail::HashName("foobar") == 0x85944171f73967e8ULL);
+        EXPECT(StableComponentKey("foobar") == 0x85944171f73967e8ULL);
+    },
+
+    CASE("Keys of components registered by name")
+    {
+        auto positionKey = StableComponentKey("PositionComponent");
+        EXPECT(GetStableComponentTypeId(positionKey) == ComponentTypeId<PositionComponent>());
+        EXPECT(GetStableComponentKey(ComponentTypeId<PositionComponent>()) == positionKey);
+        EXPECT(std::string{GetStableComponentName(positionKey)} == "PositionComponent");
+        EXPECT(GetStableComponentTypeId(StableComponentKey("VelocityComponent")) == ComponentTypeId<VelocityComponent>());
+
+        // registering again is allowed
+        EXPECT(RegisterStableComponentKey<PositionComponent>("PositionComponent") == positionKey);
+
+        EXPECT(GetStableComponentKey(ComponentTypeId<UnregisteredComponent>()) == INVALID_STABLE_COMPONENT_KEY);
+        EXPECT(GetStableComponentTypeId(StableComponentKey("UnregisteredComponent")) == detail::INVALID_TYPE_ID);
+        EXPECT(GetStableComponentName(StableComponentKey("UnregisteredComponent")) == nullptr);
+    },
+
+    CASE("Registering many components by name")
+    {
+        // with keys folded into the bits of a type list, 48 names would collide
+        EXPECT(RegisterNumberedComponents<48>::Register());
+        EXPECT(GetStableComponentTypeId(StableComponentKey("NumberedComponent0")) == ComponentTypeId<NumberedComponent<0>>());
+        EXPECT(GetStableComponentTypeId(StableComponentKey("NumberedComponent47")) == ComponentTypeId<NumberedComponent<47>>());
+    },
+
+    CASE("Registering two names with the same key")
+    {
+        // a collision of 64-bit hashes cannot be found by a test, so
+        // the key of PositionComponent is registered with another name
+        auto key = StableComponentKey("PositionComponent");
+        EXPECT(ThrowsNaming([&] { detail::MapStableComponentKey(key, "CollidingComponent", ComponentTypeId<DuplicateComponent>()); },
+                            "PositionComponent", "CollidingComponent"));
+        EXPECT(GetStableComponentTypeId(key) == ComponentTypeId<PositionComponent>());
+    },
+
+    CASE("Registering a name to two types")
+    {
+        EXPECT_THROWS_AS(RegisterStableComponentKey<DuplicateComponent>("PositionComponent"), anax::TestException);
+        EXPECT(GetStableComponentKey(ComponentTypeId<DuplicateComponent>()) == INVALID_STABLE_COMPONENT_KEY);
+    },
+
+    CASE("Registering a type with two names")
+    {
+        EXPECT(RegisterStableComponentKey<RenamedComponent>("OldName") == StableComponentKey("OldName"));
+        EXPECT(ThrowsNaming([] { RegisterStableComponentKey<RenamedComponent>("NewName"); }, "OldName", "NewName"));
+        EXPECT(GetStableComponentTypeId(StableComponentKey("NewName")) == detail::INVALID_TYPE_ID);
+    },
+
+    CASE("Remapping a type list through the key table")
+    {
+        World world;
+        auto entity = world.createEntity();
+        entity.addComponent<PositionComponent>();
+        entity.addComponent<VelocityComponent>();
+
+        auto typeList = entity.getComponentTypeList();
+        std::vector<std::uint64_t> keys;
+        for(detail::TypeId typeId = 0; typeId < typeList.size(); ++typeId)
+        {
+            if(typeList[typeId])
+            {
+                keys.push_back(GetStableComponentKey(typeId));
+            }
+        }
+        EXPECT(keys.size() == 2u);
+
+        detail::ComponentTypeList readTypeList;
+        for(auto key : keys)
+        {
+            readTypeList.set(GetStableComponentTypeId(key));
+        }
+        EXPECT(readTypeList == typeList);
+    }
+};
+
+int main()
+{
+    RegisterStableComponentKey<PositionComponent>("PositionComponent");
+    RegisterStableComponentKey<VelocityComponent>("VelocityComponent");
+
+    return lest::run(specification);
+}
@@ -0,0 +1,314 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <lest.hpp>
+
+#include <anax/anax.hpp>
+using namespace anax;
+
+#include "Components.hpp"
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Type IDs and filters
+//      ✓ Are type IDs the position within the component list?
+//      ✓ Are filters evaluated at compile-time?
+// 2. Entities
+//      ✓ Create entities => are they valid?
+//      ✓ Kill entities => are they invalid, and their components destroyed?
+//      ✓ Create more entities than the pool size => are components kept?
+//      ✓ Retire indices whose counter overflows => are new indices used?
+// 3. Components
+//      ✓ Add components => does the entity have them?
+//      ✓ Remove components => does the entity not have them?
+//      ✓ Add a component twice => is it replaced?
+// 4. Iterating
+//      ✓ Are only entities passing the filter visited, in order?
+//      ✓ Can entities be killed while iterating?
+// 5. Components stored within columns
+//      ✓ Are components stored and retrieved through their columns?
+//      ✓ Are columns aligned, and kept when the world grows?
+//      ✓ Are the ranges of entities passing a filter consecutive indices?
+
+namespace
+{
+    typedef StaticWorld<PositionComponent, VelocityComponent, PlayerComponent, NPCComponent> GameWorld;
+
+    static_assert(GameWorld::ComponentTypeId<PositionComponent>() == 0, "type IDs must be the position within the list");
+    static_assert(GameWorld::ComponentTypeId<NPCComponent>() == 3, "type IDs must be the position within the list");
+
+    static_assert(GameWorld::DoesPassFilter<Requires<PlayerComponent>, Excludes<NPCComponent>>((1 << 2) | (1 << 4)), "filters must be constant expressions");
+    static_assert(!GameWorld::DoesPassFilter<Requires<PlayerComponent>, Excludes<NPCComponent>>((1 << 2) | (1 << 3) | (1 << 4)), "filters must be constant expressions");
+    static_assert(!GameWorld::DoesPassFilter<Requires<PlayerComponent>>(1 << 2), "killed entities must not pass a filter");
+
+    /// A component which counts how many instances are alive
+    struct CountedComponent : Component
+    {
+        CountedComponent() { ++count; }
+        CountedComponent(const CountedComponent&) { ++count; }
+        ~CountedComponent() { --count; }
+
+        static int count;
+    };
+
+    int CountedComponent::count = 0;
+
+    /// A component stored as a column per member
+    struct ColumnComponent : Component
+    {
+        ColumnComponent(float x = 0, float y = 0) : x(x), y(y) {}
+
+        float x;
+        float y;
+    };
+}
+
+namespace anax
+{
+    template <>
+    struct ComponentColumns<ColumnComponent> : Columns<ColumnComponent, float, &ColumnComponent::x, &ColumnComponent::y> {};
+}
+
+static_assert(IsStoredInColumns<ColumnComponent>(), "components specialising ComponentColumns must be stored within columns");
+static_assert(!IsStoredInColumns<PositionComponent>(), "components must be stored within arrays by default");
+
+const lest::test specification[] =
+{
+    CASE("Create and kill entities within a static world")
+    {
+        {
+            StaticWorld<PlayerComponent, CountedComponent> world;
+
+            auto a = world.createEntity();
+            auto b = world.createEntity();
+            EXPECT(world.isValid(a));
+            EXPECT(world.isValid(b));
+            EXPECT(world.getEntityCount() == 2);
+
+            world.addComponent<PlayerComponent>(a).name = "a";
+            world.addComponent<CountedComponent>(a);
+            world.addComponent<CountedComponent>(b);
+            EXPECT(CountedComponent::count == 2);
+
+            world.killEntity(a);
+            EXPECT(!world.isValid(a));
+            EXPECT(!world.hasComponent<PlayerComponent>(a));
+            EXPECT(world.getEntityCount() == 1);
+            EXPECT(CountedComponent::count == 1);
+
+            // the index is re-used, with a different counter
+            auto c = world.createEntity();
+            EXPECT(world.isValid(c));
+            EXPECT(!world.isValid(a));
+            EXPECT(!world.hasComponent<CountedComponent>(c));
+        }
+
+        // the world destroys the remaining components
+        EXPECT(CountedComponent::count == 0);
+    },
+
+    CASE("Create more entities than the pool size of a static world")
+    {
+        StaticWorld<PositionComponent, PlayerComponent> world(2);
+
+        std::vector<StaticWorld<PositionComponent, PlayerComponent>::Id> entities;
+        for(int i = 0; i < 100; ++i)
+        {
+            auto e = world.createEntity();
+            world.addComponent<PositionComponent>(e).x = static_cast<float>(i);
+            world.addComponent<PlayerComponent>(e).name = "a player with a name too long for small string optimisation " + std::to_string(i);
+            entities.push_back(e);
+        }
+
+        EXPECT(world.getEntityCount() == 100);
+        for(int i = 0; i < 100; ++i)
+        {
+            EXPECT(world.getComponent<PositionComponent>(entities[i]).x == static_cast<float>(i));
+            EXPECT(world.getComponent<PlayerComponent>(entities[i]).name == "a player with a name too long for small string optimisation " + std::to_string(i));
+        }
+    },
+
+    CASE("Retire entity indices within a static world")
+    {
+        // one counter bit, so every index is used once
+        StaticWorld<PositionComponent> world(1, EntityIdLayout{4, 1});
+
+        std::vector<StaticWorld<PositionComponent>::Id> killed;
+        for(int i = 0; i < 8; ++i)
+        {
+            auto e = world.createEntity();
+            EXPECT(e.index == static_cast<Entity::Id::int_type>(i));
+            world.addComponent<PositionComponent>(e);
+            world.killEntity(e);
+            killed.push_back(e);
+        }
+
+        auto e = world.createEntity();
+        EXPECT(world.isValid(e));
+        EXPECT(world.getEntityCount() == 1);
+        for(auto id : killed)
+        {
+            EXPECT(!world.isValid(id));
+        }
+    },
+
+    CASE("Add, replace and remove components within a static world")
+    {
+        GameWorld world;
+        auto e = world.createEntity();
+
+        EXPECT(!world.hasComponent<PositionComponent>(e));
+        EXPECT(world.getComponentMask(e) == (1 << 4));
+
+        world.addComponent<PositionComponent>(e).x = 1;
+        EXPECT(world.hasComponent<PositionComponent>(e));
+        EXPECT(!world.hasComponent<VelocityComponent>(e));
+
+        world.addComponent<PositionComponent>(e).x = 2;
+        EXPECT(world.getComponent<PositionComponent>(e).x == 2);
+
+        world.removeComponent<PositionComponent>(e);
+        EXPECT(!world.hasComponent<PositionComponent>(e));
+        EXPECT(world.getComponentMask(e) == (1 << 4));
+    },
+
+    CASE("Iterate over the entities of a static world")
+    {
+        GameWorld world;
+
+        std::vector<GameWorld::Id> entities;
+        for(int i = 0; i < 10; ++i)
+        {
+            auto e = world.createEntity();
+            world.addComponent<PositionComponent>(e);
+            if(i % 2 == 0)
+            {
+                world.addComponent<VelocityComponent>(e).x = static_cast<float>(i);
+            }
+            if(i % 4 == 0)
+            {
+                world.addComponent<NPCComponent>(e);
+            }
+            entities.push_back(e);
+        }
+
+        std::vector<GameWorld::Id> visited;
+        world.forEach<Requires<PositionComponent, VelocityComponent>, Excludes<NPCComponent>>(
+            [&](GameWorld::Id id, PositionComponent& position, VelocityComponent& velocity)
+            {
+                position.x += velocity.x;
+                visited.push_back(id);
+            });
+
+        EXPECT(visited.size() == 2);
+        EXPECT(visited[0] == entities[2]);
+        EXPECT(visited[1] == entities[6]);
+        EXPECT(world.getComponent<PositionComponent>(entities[6]).x == 6);
+        EXPECT(world.getComponent<PositionComponent>(entities[4]).x == 0);
+
+        // kill every entity with velocity while iterating
+        world.forEach<Requires<VelocityComponent>>([&](GameWorld::Id id, VelocityComponent&)
+        {
+            world.killEntity(id);
+        });
+
+        int count = 0;
+        world.forEach<Requires<>>([&](GameWorld::Id) { ++count; });
+        EXPECT(count == 5);
+        EXPECT(world.getEntityCount() == 5);
+
+        world.clear();
+        EXPECT(world.getEntityCount() == 0);
+        EXPECT(!world.isValid(entities[1]));
+        EXPECT(world.isValid(world.createEntity()));
+    },
+
+    CASE("Components stored within columns")
+    {
+        StaticWorld<ColumnComponent, PlayerComponent> world(2);
+
+        std::vector<StaticWorld<ColumnComponent, PlayerComponent>::Id> entities;
+        for(int i = 0; i < 10; ++i)
+        {
+            entities.push_back(world.createEntity());
+            if(i != 4)
+            {
+                EXPECT(world.addComponent<ColumnComponent>(entities.back(), static_cast<float>(i), 1.0f).x == i);
+            }
+        }
+
+        auto x = world.getColumn(&ColumnComponent::x);
+        auto y = world.getColumn(&ColumnComponent::y);
+        EXPECT(x.size() == 10);
+        EXPECT(reinterpret_cast<std::uintptr_t>(x.data()) % COLUMN_ALIGNMENT == 0);
+        EXPECT(reinterpret_cast<std::uintptr_t>(y.data()) % COLUMN_ALIGNMENT == 0);
+
+        // the columns were kept while the world grew
+        for(int i = 0; i < 10; ++i)
+        {
+            EXPECT(world.hasComponent<ColumnComponent>(entities[i]) == (i != 4));
+            if(i != 4)
+            {
+                EXPECT(x[i] == i);
+                EXPECT(world.getComponent<ColumnComponent>(entities[i]).y == 1);
+            }
+        }
+
+        world.killEntity(entities[7]);
+
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        world.forEachRange<Requires<ColumnComponent>>([&](std::size_t begin, std::size_t end)
+        {
+            ranges.emplace_back(begin, end);
+            for(auto i = begin; i < end; ++i)
+            {
+                x[i] += y[i];
+            }
+        });
+
+        EXPECT(ranges.size() == 3);
+        EXPECT((ranges[0] == std::make_pair<std::size_t, std::size_t>(0, 4)));
+        EXPECT((ranges[1] == std::make_pair<std::size_t, std::size_t>(5, 7)));
+        EXPECT((ranges[2] == std::make_pair<std::size_t, std::size_t>(8, 10)));
+        EXPECT(world.getComponent<ColumnComponent>(entities[9]).x == 10);
+
+        // components stored within columns are given to forEach by value
+        float sum = 0;
+        world.forEach<Requires<ColumnComponent>>([&](StaticWorld<ColumnComponent, PlayerComponent>::Id, const ColumnComponent& component)
+        {
+            sum += component.y;
+        });
+        EXPECT(sum == 8);
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
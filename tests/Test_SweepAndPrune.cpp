@@ -0,0 +1,220 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <random>
+
+#include <anax/World.hpp>
+#include <anax/util/SweepAndPrune.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+
+using namespace anax;
+using util::SweepAndPrune;
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Inserting/removing entities
+//      ✓ Insert entity => is it contained?
+//      ✓ Insert entity twice => does it assert?
+//      ✓ Remove entity => is it no longer contained?
+// 2. Queries
+//      ✓ Pair query => does it match a brute force check?
+//      ✓ Zero-width bounds starting at the same x => are they not overlapping?
+//      ✓ Update bounds => are queries correct after moving?
+//      ✓ Remove/insert between queries => are queries still correct?
+
+namespace
+{
+    SweepAndPrune::Bounds makeBounds(float x, float y, float width, float height)
+    {
+        return SweepAndPrune::Bounds{x, y, x + width, y + height};
+    }
+
+    std::size_t countBruteForcePairs(const std::vector<SweepAndPrune::Bounds>& bounds, const std::vector<bool>& isInserted)
+    {
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < bounds.size(); ++i)
+            for(std::size_t j = i + 1; j < bounds.size(); ++j)
+                if(isInserted[i] && isInserted[j] && bounds[i].intersects(bounds[j]))
+                    ++count;
+        return count;
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Inserting entities into a sweep and prune")
+    {
+        World world;
+        SweepAndPrune sweepAndPrune;
+
+        auto e = world.createEntity();
+        sweepAndPrune.insert(e, makeBounds(0, 0, 5, 5));
+
+        EXPECT(sweepAndPrune.contains(e) == true);
+        EXPECT(sweepAndPrune.getSize() == 1);
+        EXPECT_THROWS_AS(sweepAndPrune.insert(e, makeBounds(0, 0, 5, 5)), anax::TestException);
+    },
+
+    CASE("Removing entities from a sweep and prune")
+    {
+        World world;
+        SweepAndPrune sweepAndPrune;
+
+        auto e1 = world.createEntity();
+        auto e2 = world.createEntity();
+        sweepAndPrune.insert(e1, makeBounds(0, 0, 5, 5));
+        sweepAndPrune.insert(e2, makeBounds(1, 1, 5, 5));
+        sweepAndPrune.remove(e1);
+
+        EXPECT(sweepAndPrune.contains(e1) == false);
+        EXPECT(sweepAndPrune.getSize() == 1);
+
+        std::vector<SweepAndPrune::EntityPair> pairs;
+        sweepAndPrune.queryPairs(pairs);
+        EXPECT(pairs.empty());
+    },
+
+    CASE("Querying pairs of a sweep and prune")
+    {
+        World world;
+        SweepAndPrune sweepAndPrune;
+
+        std::mt19937 random{42};
+        std::uniform_real_distribution<float> position{-100, 100};
+        std::uniform_real_distribution<float> size{1, 20};
+
+        std::vector<SweepAndPrune::Bounds> bounds;
+        for(auto& e : world.createEntities(500))
+        {
+            bounds.push_back(makeBounds(position(random), position(random), size(random), size(random)));
+            sweepAndPrune.insert(e, bounds.back());
+        }
+
+        std::vector<SweepAndPrune::EntityPair> pairs;
+        sweepAndPrune.queryPairs(pairs);
+
+        EXPECT(pairs.size() == countBruteForcePairs(bounds, std::vector<bool>(bounds.size(), true)));
+    },
+
+    CASE("Querying pairs of zero-width bounds within a sweep and prune")
+    {
+        World world;
+        SweepAndPrune sweepAndPrune;
+
+        // enough zero-width bounds for the candidates to be tested four at once
+        std::vector<SweepAndPrune::Bounds> bounds;
+        for(auto& e : world.createEntities(9))
+        {
+            bounds.push_back(makeBounds(0, 0, bounds.empty() ? 1.0f : 0.0f, 1));
+            sweepAndPrune.insert(e, bounds.back());
+        }
+
+        std::vector<SweepAndPrune::EntityPair> pairs;
+        sweepAndPrune.queryPairs(pairs);
+
+        EXPECT(countBruteForcePairs(bounds, std::vector<bool>(bounds.size(), true)) == 0);
+        EXPECT(pairs.empty());
+    },
+
+    CASE("Updating the bounds of entities within a sweep and prune")
+    {
+        World world;
+        SweepAndPrune sweepAndPrune;
+
+        auto e1 = world.createEntity();
+        auto e2 = world.createEntity();
+        sweepAndPrune.insert(e1, makeBounds(0, 0, 5, 5));
+        sweepAndPrune.insert(e2, makeBounds(100, 100, 5, 5));
+
+        std::vector<SweepAndPrune::EntityPair> pairs;
+        sweepAndPrune.queryPairs(pairs);
+        EXPECT(pairs.empty());
+
+        sweepAndPrune.update(e2, makeBounds(2, 2, 5, 5));
+        sweepAndPrune.queryPairs(pairs);
+        EXPECT(pairs.size() == 1);
+
+        pairs.clear();
+        sweepAndPrune.update(e2, makeBounds(-50, 2, 5, 5));
+        sweepAndPrune.queryPairs(pairs);
+        EXPECT(pairs.empty());
+    },
+
+    CASE("Moving, inserting and removing entities between queries of a sweep and prune")
+    {
+        World world;
+        SweepAndPrune sweepAndPrune;
+
+        std::mt19937 random{7};
+        std::uniform_real_distribution<float> position{-100, 100};
+        std::uniform_real_distribution<float> speed{-5, 5};
+        std::uniform_int_distribution<std::size_t> pick{0, 299};
+
+        auto entities = world.createEntities(300);
+        std::vector<SweepAndPrune::Bounds> bounds;
+        std::vector<bool> isInserted(entities.size(), true);
+        for(auto& e : entities)
+        {
+            bounds.push_back(makeBounds(position(random), position(random), 8, 8));
+            sweepAndPrune.insert(e, bounds.back());
+        }
+
+        for(int step = 0; step < 20; ++step)
+        {
+            for(std::size_t i = 0; i < entities.size(); ++i)
+            {
+                if(!isInserted[i])
+                    continue;
+
+                auto dx = speed(random);
+                auto dy = speed(random);
+                bounds[i] = makeBounds(bounds[i].minX + dx, bounds[i].minY + dy, 8, 8);
+                sweepAndPrune.update(entities[i], bounds[i]);
+            }
+
+            for(int i = 0; i < 5; ++i)
+            {
+                auto index = pick(random);
+                if(isInserted[index])
+                    sweepAndPrune.remove(entities[index]);
+                else
+                    sweepAndPrune.insert(entities[index], bounds[index]);
+
+                isInserted[index] = !isInserted[index];
+            }
+
+            std::vector<SweepAndPrune::EntityPair> pairs;
+            sweepAndPrune.queryPairs(pairs);
+            EXPECT(pairs.size() == countBruteForcePairs(bounds, isInserted));
+        }
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
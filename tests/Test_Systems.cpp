@@ -25,6 +25,7 @@
 
 #include "lest.hpp"
 
+#include <algorithm>
 #include <sstream>
 
 #include <anax/anax.hpp>
@@ -33,6 +34,42 @@ using namespace anax;
 
 #include "Systems.hpp"
 
+namespace
+{
+    /// Records whether each entity is within the system when it is notified
+    class NotifiedSystem : public anax::System<anax::Requires<PositionComponent>>
+    {
+    public:
+
+        bool contains(const anax::Entity& entity) const
+        {
+            auto& handles = getEntityHandles();
+            return std::find(handles.begin(), handles.end(), anax::EntityHandle{entity}) != handles.end();
+        }
+
+        std::size_t addedCount = 0;
+        std::size_t removedCount = 0;
+        bool wasAddedWithin = true;
+        bool wasRemovedWithout = true;
+        bool wasRemovedValid = true;
+
+    private:
+
+        virtual void onEntityAdded(anax::Entity& e) override
+        {
+            ++addedCount;
+            wasAddedWithin = wasAddedWithin && contains(e);
+        }
+
+        virtual void onEntityRemoved(anax::Entity& e) override
+        {
+            ++removedCount;
+            wasRemovedWithout = wasRemovedWithout && !contains(e);
+            wasRemovedValid = wasRemovedValid && e.isValid() && e.hasComponent<PositionComponent>();
+        }
+    };
+}
+
 // Since systems are tightly bound to the world attached to them, 
 // we will also be testing that the world.
 //
@@ -49,6 +86,18 @@ using namespace anax;
 //    ✓ Does the getWorld() function assert?
 //    ✓ Does the system no longer exist in the world?
 //    ✓ Are there no entities attached to the system?
+// 4. Ordering the entities of a system
+//    ✓ Are entities kept in the order they were activated?
+//    ✓ Are entities kept sorted by index, while adding and removing them?
+//    ✓ Does an entity activated and deactivated within one refresh stay out of the system?
+// 5. Notifying a system of its entities
+//    ✓ Is an added entity within the entities of the system when the system is notified?
+//    ✓ Is a removed entity no longer within the entities of the system when the system is notified?
+//    ✓ Is a killed entity still valid when the system is notified?
+// 6. Caching the components of a system
+//    ✓ Are the cached components those of the entities of the system?
+//    ✓ Are the cached components updated when entities are added, removed or activated again?
+//    ✓ Are the cached components cleared when the system is removed from the world?
 //
 const lest::test specification[] =
 {
@@ -206,6 +255,202 @@ const lest::test specification[] =
         world.refresh();
         moveSystem.update();
     },
+
+    CASE("Entities are kept in the order they were activated")
+    {
+        anax::World world;
+        MovementSystem moveSystem;
+        world.addSystem(moveSystem);
+
+        EXPECT(moveSystem.getEntityOrder() == MovementSystem::EntityOrder::ACTIVATION);
+
+        std::vector<Entity> entities;
+        for(int i = 0; i < 6; ++i)
+        {
+            auto e = world.createEntity();
+            e.addComponent<PositionComponent>();
+            e.addComponent<VelocityComponent>();
+            entities.push_back(e);
+        }
+
+        for(int i = 5; i >= 0; --i)
+        {
+            entities[i].activate();
+        }
+        world.refresh();
+
+        entities[3].kill();
+        world.refresh();
+
+        auto systemEntities = moveSystem.getEntities();
+        EXPECT(systemEntities.size() == 5);
+        EXPECT(systemEntities[0] == entities[5]);
+        EXPECT(systemEntities[1] == entities[4]);
+        EXPECT(systemEntities[2] == entities[2]);
+        EXPECT(systemEntities[3] == entities[1]);
+        EXPECT(systemEntities[4] == entities[0]);
+    },
+
+    CASE("Entities are kept sorted by index")
+    {
+        anax::World world;
+        MovementSystem moveSystem;
+        world.addSystem(moveSystem);
+
+        std::vector<Entity> entities;
+        for(int i = 0; i < 8; ++i)
+        {
+            auto e = world.createEntity();
+            e.addComponent<PositionComponent>();
+            e.addComponent<VelocityComponent>();
+            entities.push_back(e);
+        }
+
+        for(int i = 7; i >= 4; --i)
+        {
+            entities[i].activate();
+        }
+        world.refresh();
+
+        // re-sorts the entities already within the system
+        moveSystem.setEntityOrder(MovementSystem::EntityOrder::INDEX);
+        EXPECT(moveSystem.getEntities()[0] == entities[4]);
+
+        // merges new entities into the list, while removing others
+        for(int i = 3; i >= 0; --i)
+        {
+            entities[i].activate();
+        }
+        entities[5].kill();
+        entities[2].deactivate();
+        world.refresh();
+
+        auto handles = moveSystem.getEntityHandles();
+        EXPECT(handles.size() == 6);
+        for(std::size_t i = 1; i < handles.size(); ++i)
+        {
+            EXPECT(handles[i - 1].getId().index < handles[i].getId().index);
+        }
+
+        auto e = world.createEntity(); // re-uses the index of entities[5]
+        e.addComponent<PositionComponent>();
+        e.addComponent<VelocityComponent>();
+        e.activate();
+        world.refresh();
+
+        EXPECT(moveSystem.getEntities().size() == 7);
+        EXPECT(moveSystem.getEntities()[4] == e);
+    },
+
+    CASE("An entity activated and deactivated within one refresh is not added to a system")
+    {
+        anax::World world;
+        MovementSystem moveSystem;
+        world.addSystem(moveSystem);
+
+        auto e = world.createEntity();
+        e.addComponent<PositionComponent>();
+        e.addComponent<VelocityComponent>();
+        e.activate();
+        e.deactivate();
+        world.refresh();
+
+        EXPECT(moveSystem.getEntities().empty());
+    },
+
+    CASE("Systems are notified once their entities are updated")
+    {
+        anax::World world;
+        NotifiedSystem system;
+        world.addSystem(system);
+
+        auto e1 = world.createEntity();
+        e1.addComponent<PositionComponent>();
+        e1.activate();
+        auto e2 = world.createEntity();
+        e2.addComponent<PositionComponent>();
+        e2.activate();
+        world.refresh();
+        EXPECT(system.addedCount == 2u);
+        EXPECT(system.wasAddedWithin);
+
+        e1.deactivate();
+        e2.kill();
+        world.refresh();
+        EXPECT(system.removedCount == 2u);
+        EXPECT(system.wasRemovedWithout);
+        EXPECT(system.wasRemovedValid);
+
+        // never within the system, so it is neither added nor removed
+        e1.activate();
+        e1.deactivate();
+        world.refresh();
+        EXPECT(system.addedCount == 2u);
+        EXPECT(system.removedCount == 2u);
+    },
+
+    CASE("Caching the components of a system")
+    {
+        anax::World world;
+        CachedMovementSystem moveSystem;
+        world.addSystem(moveSystem);
+
+        std::vector<Entity> entities;
+        for(int i = 0; i < 4; ++i)
+        {
+            auto e = world.createEntity();
+            e.addComponent<PositionComponent>();
+            e.addComponent<VelocityComponent>().x = static_cast<float>(i);
+            e.activate();
+            entities.push_back(e);
+        }
+        world.refresh();
+
+        EXPECT(moveSystem.getComponentTuples().size() == 4);
+        for(std::size_t i = 0; i < entities.size(); ++i)
+        {
+            auto& tuple = moveSystem.getComponentTuples()[i];
+            EXPECT(std::get<0>(tuple) == moveSystem.getEntities()[i]);
+            EXPECT(std::get<1>(tuple) == &std::get<0>(tuple).getComponent<PositionComponent>());
+            EXPECT(std::get<2>(tuple) == &std::get<0>(tuple).getComponent<VelocityComponent>());
+        }
+
+        moveSystem.update();
+        EXPECT(entities[3].getComponent<PositionComponent>().x == 3);
+    },
+
+    CASE("Cached components are updated by refreshing the world")
+    {
+        anax::World world;
+        CachedMovementSystem moveSystem;
+        world.addSystem(moveSystem);
+
+        auto e1 = world.createEntity();
+        e1.addComponent<PositionComponent>();
+        e1.addComponent<VelocityComponent>();
+        e1.activate();
+        world.refresh();
+        EXPECT(moveSystem.getComponentTuples().size() == 1);
+
+        auto e2 = world.createEntity();
+        e2.addComponent<PositionComponent>();
+        e2.addComponent<VelocityComponent>();
+        e2.activate();
+        e1.kill();
+        world.refresh();
+        EXPECT(moveSystem.getComponentTuples().size() == 1);
+        EXPECT(std::get<0>(moveSystem.getComponentTuples()[0]) == e2);
+
+        // replacing a component and activating the entity again
+        e2.removeComponent<VelocityComponent>();
+        e2.addComponent<VelocityComponent>().x = 2;
+        e2.activate();
+        world.refresh();
+        EXPECT(std::get<2>(moveSystem.getComponentTuples()[0]) == &e2.getComponent<VelocityComponent>());
+
+        world.removeSystem<CachedMovementSystem>();
+        EXPECT(moveSystem.getComponentTuples().empty());
+    },
 };
 
 int main()
@@ -0,0 +1,166 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <anax/anax.hpp>
+#include <anax/util/TraceRecorder.hpp>
+using namespace anax;
+using util::TraceRecorder;
+
+#include "Systems.hpp"
+
+// NOTE: this test is only built if tracing is enabled
+//
+// Here are the possible test cases we need to test for:
+//
+// 1. Recording events
+//      ✓ Record events from many threads => are they all written?
+//      ✓ Record more events than a buffer holds => are events dropped, not blocked on?
+// 2. Tracing a world
+//      ✓ Refresh/update systems => are phases, systems and counters written?
+
+namespace
+{
+    const char* TRACE_FILEPATH = "test_tracerecorder.json";
+
+    std::string readFile(const char* filepath)
+    {
+        std::ifstream file{filepath};
+        std::stringstream stream;
+        stream << file.rdbuf();
+        return stream.str();
+    }
+
+    std::size_t count(const std::string& str, const std::string& substr)
+    {
+        std::size_t result = 0;
+        for(auto i = str.find(substr); i != std::string::npos; i = str.find(substr, i + 1))
+            ++result;
+        return result;
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Recording events from many threads")
+    {
+        {
+            TraceRecorder recorder{TRACE_FILEPATH};
+            EXPECT(recorder.isOpen());
+
+            auto recordEvents = [&recorder](const char* threadName)
+            {
+                recorder.setThreadName(threadName);
+                for(int i = 0; i < 100; ++i)
+                {
+                    TraceRecorder::Scope scope{&recorder, "task"};
+                    recorder.recordCounter("tasks", i);
+                }
+            };
+
+            std::thread worker1{recordEvents, "worker 1"};
+            std::thread worker2{recordEvents, "worker 2"};
+            worker1.join();
+            worker2.join();
+
+            EXPECT(recorder.getDroppedEventCount() == 0);
+        }
+
+        auto trace = readFile(TRACE_FILEPATH);
+        EXPECT(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+        EXPECT(trace.find("]}") != std::string::npos);
+        EXPECT(count(trace, "\"name\":\"task\"") == 200);
+        EXPECT(count(trace, "\"name\":\"tasks\"") == 200);
+        EXPECT(count(trace, "\"name\":\"worker 1\"") == 1);
+        EXPECT(count(trace, "\"name\":\"worker 2\"") == 1);
+
+        std::remove(TRACE_FILEPATH);
+    },
+
+    CASE("Recording more events than a buffer holds")
+    {
+        std::size_t dropped;
+        {
+            TraceRecorder recorder{TRACE_FILEPATH, 16};
+
+            for(int i = 0; i < 1000; ++i)
+                recorder.recordCounter("value", i);
+
+            // the background thread may drain some events whilst
+            // recording, thus at most (events - capacity) are dropped
+            dropped = recorder.getDroppedEventCount();
+            EXPECT(dropped <= 1000 - 16);
+        }
+
+        auto trace = readFile(TRACE_FILEPATH);
+        EXPECT(count(trace, "\"name\":\"value\"") == 1000 - dropped);
+
+        std::remove(TRACE_FILEPATH);
+    },
+
+    CASE("Tracing a world")
+    {
+        {
+            TraceRecorder recorder{TRACE_FILEPATH};
+
+            World world;
+            MovementSystem movementSystem;
+            world.addSystem(movementSystem);
+            world.setTraceRecorder(&recorder);
+
+            for(auto& e : world.createEntities(10))
+            {
+                e.addComponent<PositionComponent>();
+                e.addComponent<VelocityComponent>();
+                e.activate();
+            }
+
+            world.refresh();
+            world.updateSystem(movementSystem);
+        }
+
+        auto trace = readFile(TRACE_FILEPATH);
+        EXPECT(count(trace, "\"name\":\"World::refresh\"") == 1);
+        EXPECT(count(trace, "\"name\":\"refresh: activated\"") == 1);
+        EXPECT(count(trace, "\"name\":\"refresh: deactivated\"") == 1);
+        EXPECT(count(trace, "\"name\":\"refresh: killed\"") == 1);
+        EXPECT(count(trace, "\"name\":\"MovementSystem\"") == 1);
+        EXPECT(count(trace, "\"name\":\"entities\",\"pid\":1,\"tid\":1,\"ph\":\"C\"") == 1);
+
+        std::remove(TRACE_FILEPATH);
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
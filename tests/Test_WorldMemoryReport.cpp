@@ -0,0 +1,160 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <anax/anax.hpp>
+using namespace anax;
+
+#include "Systems.hpp"
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Components
+//      ✓ Are alive components and reserved memory reported for each type?
+//      ✓ Is the fragmentation reported once components are removed?
+//      ✓ Are types without components not reported?
+// 2. Entities and systems
+//      ✓ Is the memory of the entity ID pool, attributes and cache reported?
+//      ✓ Are the entities within each system reported?
+//      ✓ Are the cached components of a system reported?
+//      ✓ Is the total the sum of every part?
+
+const lest::test specification[] =
+{
+    CASE("Memory report of components")
+    {
+        World world;
+
+        auto entities = world.createEntities(100);
+        for(auto& e : entities)
+        {
+            e.addComponent<PositionComponent>();
+        }
+        for(std::size_t i = 0; i < 10; ++i)
+        {
+            entities[i].addComponent<VelocityComponent>();
+        }
+
+        auto report = world.getMemoryReport();
+        auto position = report.getComponentMemory<PositionComponent>();
+        auto velocity = report.getComponentMemory<VelocityComponent>();
+
+        EXPECT(position != nullptr);
+        EXPECT(velocity != nullptr);
+        EXPECT(report.getComponentMemory<PlayerComponent>() == nullptr);
+
+        EXPECT(position->instanceCount == 100);
+        EXPECT(position->capacity >= 100);
+        EXPECT(position->stride >= sizeof(PositionComponent));
+        EXPECT(position->memory.usedBytes >= 100 * sizeof(PositionComponent));
+        EXPECT(position->memory.reservedBytes >= position->memory.usedBytes);
+        EXPECT(velocity->instanceCount == 10);
+
+        for(std::size_t i = 0; i < 50; ++i)
+        {
+            entities[i].removeComponent<PositionComponent>();
+        }
+
+        auto reportAfterRemoval = world.getMemoryReport();
+        auto afterRemoval = reportAfterRemoval.getComponentMemory<PositionComponent>();
+        EXPECT(afterRemoval->instanceCount == 50);
+        EXPECT(afterRemoval->capacity == position->capacity);
+        EXPECT(afterRemoval->memory.usedBytes < position->memory.usedBytes);
+        EXPECT(afterRemoval->fragmentation > position->fragmentation);
+        EXPECT(afterRemoval->fragmentation < 1.0);
+    },
+
+    CASE("Memory report of entities and systems")
+    {
+        World world;
+        MovementSystem movementSystem;
+        PlayerSystem playerSystem;
+        world.addSystem(movementSystem);
+        world.addSystem(playerSystem);
+
+        auto entities = world.createEntities(20);
+        for(auto& e : entities)
+        {
+            e.addComponent<PositionComponent>();
+            e.addComponent<VelocityComponent>();
+            e.activate();
+        }
+        world.refresh();
+
+        auto report = world.getMemoryReport();
+        EXPECT(report.entityIdPool.usedBytes >= 20 * sizeof(Entity::Id::int_type));
+        EXPECT(report.entityAttributes.usedBytes > 0);
+        EXPECT(report.componentEntries.usedBytes > 0);
+        EXPECT(report.entityCache.usedBytes >= 20 * sizeof(EntityHandle));
+
+        auto movement = report.getSystemMemory<MovementSystem>();
+        auto player = report.getSystemMemory<PlayerSystem>();
+        EXPECT(movement != nullptr);
+        EXPECT(player != nullptr);
+        EXPECT(movement->entityCount == 20);
+        EXPECT(movement->memory.usedBytes == 20 * sizeof(EntityHandle));
+        EXPECT(player->entityCount == 0);
+
+        std::size_t reserved = report.entityIdPool.reservedBytes + report.entityAttributes.reservedBytes +
+                               report.componentEntries.reservedBytes + report.entityCache.reservedBytes +
+                               report.hierarchy.reservedBytes;
+        for(auto& component : report.components)
+            reserved += component.memory.reservedBytes;
+        for(auto& system : report.systems)
+            reserved += system.memory.reservedBytes;
+
+        EXPECT(report.getTotal().reservedBytes == reserved);
+        EXPECT(report.getTotal().usedBytes <= report.getTotal().reservedBytes);
+    },
+
+    CASE("Memory report of a system that caches components")
+    {
+        World world;
+        CachedMovementSystem movementSystem;
+        world.addSystem(movementSystem);
+
+        auto entities = world.createEntities(20);
+        for(auto& e : entities)
+        {
+            e.addComponent<PositionComponent>();
+            e.addComponent<VelocityComponent>();
+            e.activate();
+        }
+        world.refresh();
+
+        auto uncached = world.getMemoryReport().getSystemMemory<CachedMovementSystem>()->memory;
+        EXPECT(movementSystem.getComponentTuples().size() == 20);
+        auto cached = world.getMemoryReport().getSystemMemory<CachedMovementSystem>()->memory;
+
+        EXPECT(uncached.usedBytes >= 20 * sizeof(EntityHandle));
+        EXPECT(cached.usedBytes == uncached.usedBytes + 20 * sizeof(CachedMovementSystem::ComponentTuple));
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}
@@ -0,0 +1,146 @@
+///
+/// anax
+/// An open source C++ entity system.
+///
+/// Copyright (C) 2013-2014 Miguel Martin (miguel@miguel-martin.com)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+
+#include <lest.hpp>
+
+#include <anax/anax.hpp>
+#include <anax/detail/AnaxAssert.hpp>
+using namespace anax;
+
+#include "Systems.hpp"
+
+// Here are the possible test cases we need to test for:
+//
+// 1. Refreshing a world
+//      ✓ Activate entities => are activations, filter checks and adds counted?
+//      ✓ Kill entities => are kills and removes counted?
+//      ✓ Reset statistics => are the statistics zero?
+// 2. Updating a system through the world
+//      ✓ Is the system updated?
+//      ✓ Are updates and entities counted?
+//
+// NOTE: if statistics are not enabled, every statistic must be zero
+
+namespace
+{
+    World::EntityArray createMovingEntities(World& world, std::size_t amount)
+    {
+        auto entities = world.createEntities(amount);
+        for(auto& e : entities)
+        {
+            e.addComponent<PositionComponent>();
+            e.addComponent<VelocityComponent>().x = 1;
+            e.activate();
+        }
+
+        return entities;
+    }
+
+#ifdef ANAX_ENABLE_STATS
+    const bool STATS_ENABLED = true;
+#else
+    const bool STATS_ENABLED = false;
+#endif // ANAX_ENABLE_STATS
+
+    /// \return The value if statistics are enabled, 0 otherwise
+    std::size_t expected(std::size_t value)
+    {
+        return STATS_ENABLED ? value : 0;
+    }
+}
+
+const lest::test specification[] =
+{
+    CASE("Statistics of refreshing a world")
+    {
+        World world;
+        MovementSystem movementSystem;
+        PlayerSystem playerSystem;
+        world.addSystem(movementSystem);
+        world.addSystem(playerSystem);
+
+        auto entities = createMovingEntities(world, 10);
+        world.refresh();
+
+        auto& stats = world.getStats();
+        EXPECT(stats.refreshCount == expected(1));
+        EXPECT(stats.lastRefresh.activatedCount == expected(10));
+        EXPECT(stats.lastRefresh.filterChecks == expected(20));
+        EXPECT(stats.lastRefresh.systemAdds == expected(10));
+        EXPECT(stats.lastRefresh.killedCount == 0);
+
+        world.killEntity(entities[0]);
+        world.killEntity(entities[1]);
+        world.refresh();
+
+        EXPECT(stats.refreshCount == expected(2));
+        EXPECT(stats.lastRefresh.activatedCount == 0);
+        EXPECT(stats.lastRefresh.deactivatedCount == expected(2));
+        EXPECT(stats.lastRefresh.killedCount == expected(2));
+        EXPECT(stats.lastRefresh.systemRemoves == expected(2));
+        EXPECT(stats.totalRefresh.systemAdds == expected(10));
+        EXPECT(stats.totalRefresh.totalTime >= stats.lastRefresh.totalTime);
+
+        world.resetStats();
+        EXPECT(stats.refreshCount == 0);
+        EXPECT(stats.totalRefresh.systemAdds == 0);
+        EXPECT(stats.totalRefresh.totalTime.count() == 0);
+    },
+
+    CASE("Statistics of updating a system through a world")
+    {
+        World world;
+        MovementSystem movementSystem;
+        world.addSystem(movementSystem);
+
+        auto entities = createMovingEntities(world, 5);
+        world.refresh();
+
+        world.updateSystem(movementSystem);
+        world.updateSystem(movementSystem);
+
+        EXPECT(entities[0].getComponent<PositionComponent>().x == 2);
+
+        auto systemStats = world.getStats().getSystemStats<MovementSystem>();
+        if(STATS_ENABLED)
+        {
+            EXPECT(systemStats != nullptr);
+            EXPECT(systemStats->updateCount == 2);
+            EXPECT(systemStats->entityCount == 5);
+            EXPECT(systemStats->totalUpdateTime >= systemStats->lastUpdateTime);
+        }
+        else
+        {
+            EXPECT(systemStats == nullptr);
+        }
+
+        EXPECT(world.getStats().getSystemStats<PlayerSystem>() == nullptr);
+    }
+};
+
+int main()
+{
+    return lest::run(specification);
+}